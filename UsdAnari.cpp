@@ -406,6 +406,11 @@ void reportStatusThroughDevice(const UsdLogInfo& logInfo, ANARIStatusSeverity se
     logInfo.device->reportStatus(logInfo.source, logInfo.sourceType, severity, statusCode, format, firstArg, secondArg);
 }
 
+UsdSharedString* internStringThroughDevice(UsdDevice* device, const char* str)
+{
+  return device->internString(str);
+}
+
 #ifdef CHECK_MEMLEAKS
 void logAllocationThroughDevice(UsdDevice* device, const void* ptr, ANARIDataType ptrType)
 {
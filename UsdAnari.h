@@ -31,6 +31,8 @@ class UsdSharedString;
 class UsdBaseObject;
 struct UsdDataLayout;
 
+struct UsdUnusedParamType {}; // Fills the unused type slots of a UsdMultiTypeParameter
+
 namespace anari
 {
   static_assert(sizeof(bool) >= sizeof(ANARITypeProperties<ANARI_BOOL>::base_type));
@@ -57,6 +59,7 @@ namespace anari
   ANARI_TYPEFOR_SPECIALIZATION(UsdSurface*, ANARI_SURFACE);
   ANARI_TYPEFOR_SPECIALIZATION(UsdVolume*, ANARI_VOLUME);
   ANARI_TYPEFOR_SPECIALIZATION(UsdWorld*, ANARI_WORLD);
+  ANARI_TYPEFOR_SPECIALIZATION(UsdUnusedParamType, ANARI_UNKNOWN);
 }
 
 // Helper templates which allow for bool usage as param type 
@@ -121,6 +124,8 @@ struct UsdLogInfo
 void reportStatusThroughDevice(const UsdLogInfo& logInfo, ANARIStatusSeverity severity, ANARIStatusCode statusCode,
   const char *format, const char* firstArg, const char* secondArg); // In case #include <UsdDevice.h> is undesired
 
+UsdSharedString* internStringThroughDevice(UsdDevice* device, const char* str); // Returns the device-wide shared string for str, kept alive by the device
+
 #ifdef CHECK_MEMLEAKS  
 void logAllocationThroughDevice(UsdDevice* device, const void* ptr, ANARIDataType ptrType);
 void logDeallocationThroughDevice(UsdDevice* device, const void* ptr, ANARIDataType ptrType);
@@ -157,8 +157,10 @@ class UsdParameterizedBaseObject : public UsdBaseObject, public UsdParameterized
           else
           {
             ParamClass::setParam(name, type, mem, device);
-            ParamClass::setParam("usd::name", type, mem, device);
-            this->formatUsdName(this->getWriteParams().usdName);
+
+            std::string usdName(objectName);
+            this->formatUsdName(usdName);
+            ParamClass::setParam("usd::name", type, usdName.c_str(), device);
           }
           return true;
         }
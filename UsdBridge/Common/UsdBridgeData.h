@@ -373,6 +373,8 @@ struct UsdBridgeSettings
   bool EnablePreviewSurfaceShader = true;   // Output the preview surface shader for materials
   bool EnableMdlShader = true;              // Output the mdl shader for materials
   bool UseDisplayColorOpacity = true;      // When true, use displayColor and displayOpacity primvars instead of a color primvar with alpha channel
+  bool ShareTimeSamples = false;            // Skip time samples of time-varying geometry arrays which USD already resolves to from their neighbouring timesteps
+  bool PackClipStages = false;              // Write the clip data of all prims for a timestep into a single clip stage, instead of a clip stage per prim and timestep
 
   // MPI parallel support (KHR_DATA_PARALLEL_MPI)
   int MpiRank = -1;                         // MPI rank of this process (-1 = no MPI)
@@ -383,6 +385,14 @@ struct UsdBridgeSettings
   static constexpr bool EnableStTexCoords = false;
 };
 
+// Output precision of generic attributes with FLOAT or DOUBLE components, other data types are always written as-is
+enum class UsdBridgeAttributePrecision
+{
+  NATIVE = 0,   // Written at the precision of DataType
+  HALF,         // Written as half(2/3/4) primvar
+  NORMALIZED8   // Quantized per component to [0,255] uchar primvar, with <name>_quantScale and <name>_quantOffset constant primvars
+};
+
 // Generic attribute definition
 struct UsdBridgeAttribute
 {
@@ -391,6 +401,13 @@ struct UsdBridgeAttribute
   bool PerPrimData = false;
   uint32_t EltSize = 0;
   const char* Name = nullptr;
+  UsdBridgeAttributePrecision OutputPrecision = UsdBridgeAttributePrecision::NATIVE;
+};
+
+struct UsdBridgeMeshLod
+{
+  const int* Indices = nullptr; // Triangle indices into the points of the full mesh
+  uint64_t NumIndices = 0;
 };
 
 struct UsdBridgeMeshData
@@ -421,7 +438,8 @@ struct UsdBridgeMeshData
     ATTRIBUTE13 = (1 << 17),
     ATTRIBUTE14 = (1 << 18),
     ATTRIBUTE15 = (1 << 19),
-    ALL = (1 << 20) - 1
+    LINEARVELOCITIES = (1 << 20),
+    ALL = (1 << 21) - 1
   };
   
   DataMemberId UpdatesToPerform = DataMemberId::ALL;
@@ -440,6 +458,7 @@ struct UsdBridgeMeshData
   const void* Colors = nullptr;
   UsdBridgeType ColorsType = UsdBridgeType::UNDEFINED;
   bool PerPrimColors = false;
+  const float* LinearVelocities = nullptr; // 3 component float, one for every point
   const UsdBridgeAttribute* Attributes = nullptr; // Pointer to externally managed attribute array
   uint32_t NumAttributes = 0;
 
@@ -448,6 +467,9 @@ struct UsdBridgeMeshData
   uint64_t NumIndices = 0;
 
   int FaceVertexCount = 0;
+
+  const UsdBridgeMeshLod* Lods = nullptr; // Simplified topologies, output as variants of the mesh (only with uniform indices)
+  uint32_t NumLods = 0;
 };
 
 struct UsdBridgeInstancerData
@@ -518,6 +540,15 @@ struct UsdBridgeInstancerData
   UsdBridgeType InvisibleIdsType = UsdBridgeType::UNDEFINED;
 };
 
+struct UsdBridgeInstanceBatch
+{
+  UsdGroupHandle Group;
+  const float* Transforms = nullptr; // NumTransforms consecutive 4x4 matrices, in the same layout as UsdBridge::SetInstanceTransform
+  uint64_t NumTransforms = 0;
+  bool TimeVarying = false; // Transforms are written as a sample at the timestep, instead of a value for all timesteps
+  bool Changed = true; // Unchanged batches keep the point instancer that has been written for them before
+};
+
 struct UsdBridgeInstancerRefData
 {
   enum InstanceShape
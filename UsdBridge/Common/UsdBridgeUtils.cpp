@@ -4,6 +4,7 @@
 #include "UsdBridgeUtils.h"
 
 #include <cmath>
+#include <cstring>
 
 namespace ubutils
 {
@@ -168,6 +169,29 @@ namespace ubutils
     return flatType;
   }
 
+  size_t UsdBridgeTypeSize(UsdBridgeType type)
+  {
+    size_t componentSize = 0;
+    switch(UsdBridgeTypeFlatten(type))
+    {
+      case UsdBridgeType::BOOL: componentSize = sizeof(bool); break;
+      case UsdBridgeType::UCHAR:
+      case UsdBridgeType::UCHAR_SRGB_R:
+      case UsdBridgeType::CHAR: componentSize = 1; break;
+      case UsdBridgeType::USHORT:
+      case UsdBridgeType::SHORT:
+      case UsdBridgeType::HALF: componentSize = 2; break;
+      case UsdBridgeType::UINT:
+      case UsdBridgeType::INT:
+      case UsdBridgeType::FLOAT: componentSize = 4; break;
+      case UsdBridgeType::ULONG:
+      case UsdBridgeType::LONG:
+      case UsdBridgeType::DOUBLE: componentSize = 8; break;
+      default: break;
+    }
+    return componentSize * UsdBridgeTypeNumComponents(type);
+  }
+
   const unsigned int SRGBTable[] =
   {
       0x00000000,0x399f22b4,0x3a1f22b4,0x3a6eb40e,0x3a9f22b4,0x3ac6eb61,0x3aeeb40e,0x3b0b3e5d,
@@ -225,4 +249,36 @@ namespace ubutils
     color[2] = SrgbToLinear(color[2]);
   }
 
-}
\ No newline at end of file
+  uint64_t HashBytes(const void* data, size_t numBytes, uint64_t seed)
+  {
+    constexpr uint64_t mulConst = 0x9E3779B97F4A7C15ull;
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    uint64_t hash = seed ^ (numBytes * mulConst);
+
+    // Process 8-byte words, tail bytes are packed into a final word
+    size_t numWords = numBytes / sizeof(uint64_t);
+    for(size_t i = 0; i < numWords; ++i)
+    {
+      uint64_t word;
+      memcpy(&word, bytes + i*sizeof(uint64_t), sizeof(uint64_t));
+      hash = (hash ^ word) * mulConst;
+      hash ^= hash >> 29;
+    }
+
+    size_t numTailBytes = numBytes - numWords*sizeof(uint64_t);
+    if(numTailBytes)
+    {
+      uint64_t word = 0;
+      memcpy(&word, bytes + numWords*sizeof(uint64_t), numTailBytes);
+      hash = (hash ^ word) * mulConst;
+    }
+
+    // Final avalanche
+    hash ^= hash >> 32;
+    hash *= mulConst;
+    hash ^= hash >> 29;
+    return hash;
+  }
+
+}
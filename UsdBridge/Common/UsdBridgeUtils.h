@@ -18,11 +18,15 @@ namespace ubutils
 {
   const char* UsdBridgeTypeToString(UsdBridgeType type);
   UsdBridgeType UsdBridgeTypeFlatten(UsdBridgeType type);
+  size_t UsdBridgeTypeSize(UsdBridgeType type); // Size in bytes of a single element, 0 if undefined
 
   const float* SrgbToLinearTable(); // returns a float[256] array
   float SrgbToLinear(float val);
   void SrgbToLinear3(float* color); // expects a float[3]
 
+  // Fast non-cryptographic 64-bit hash over a block of memory, for change detection of array contents
+  uint64_t HashBytes(const void* data, size_t numBytes, uint64_t seed = 0);
+
   template<typename DMI>
   DMI GetAttribBit(int attribIndex)
   {
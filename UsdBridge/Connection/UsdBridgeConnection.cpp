@@ -909,4 +909,102 @@ bool UsdBridgeVoidConnection::RemoveFile(const char* filePath, bool isRelative)
 bool UsdBridgeVoidConnection::ProcessUpdates()
 {
   return true;
-}
\ No newline at end of file
+}
+
+
+UsdBridgeMemoryConnection::UsdBridgeMemoryConnection()
+{
+}
+
+UsdBridgeMemoryConnection::~UsdBridgeMemoryConnection()
+{
+}
+
+const char* UsdBridgeMemoryConnection::GetBaseUrl() const
+{
+  return UsdBridgeConnection::GetBaseUrl();
+}
+
+const char* UsdBridgeMemoryConnection::GetUrl(const char* path) const
+{
+  return UsdBridgeConnection::GetUrl(path);
+}
+
+bool UsdBridgeMemoryConnection::Initialize(const UsdBridgeConnectionSettings& settings, const UsdBridgeLogObject& logObj)
+{
+  bool initialized = UsdBridgeConnection::Initialize(settings, logObj);
+  Settings.WorkingDirectory = "./";
+  return initialized;
+}
+
+void UsdBridgeMemoryConnection::Shutdown()
+{
+  Files.clear();
+  UsdBridgeConnection::Shutdown();
+}
+
+int UsdBridgeMemoryConnection::MaxSessionNr() const
+{
+  return -1;
+}
+
+bool UsdBridgeMemoryConnection::CreateFolder(const char* dirName, bool isRelative, bool mayExist) const
+{
+  return true;
+}
+
+bool UsdBridgeMemoryConnection::RemoveFolder(const char* dirName, bool isRelative) const
+{
+  std::string folderName(dirName);
+  auto it = Files.lower_bound(folderName);
+  while(it != Files.end() && it->first.compare(0, folderName.length(), folderName) == 0)
+    it = Files.erase(it);
+  return true;
+}
+
+bool UsdBridgeMemoryConnection::WriteFile(const char* data, size_t dataSize, const char* filePath, bool isRelative, bool binary) const
+{
+  try
+  {
+    Files[filePath].assign(data, data + dataSize);
+  }
+  CONNECT_CATCH(false)
+
+  return true;
+}
+
+bool UsdBridgeMemoryConnection::RemoveFile(const char* filePath, bool isRelative) const
+{
+  return Files.erase(filePath) > 0;
+}
+
+bool UsdBridgeMemoryConnection::ProcessUpdates()
+{
+  return true;
+}
+
+const std::vector<char>* UsdBridgeMemoryConnection::FindFile(const char* filePath) const
+{
+  auto it = Files.find(filePath);
+  return (it != Files.end()) ? &it->second : nullptr;
+}
+
+bool UsdBridgeMemoryConnection::ExportFiles(const char* folderName, const char* exportDirectory) const
+{
+  std::string folderPrefix(folderName);
+  bool success = true;
+  try
+  {
+    for(auto it = Files.lower_bound(folderPrefix); 
+      it != Files.end() && it->first.compare(0, folderPrefix.length(), folderPrefix) == 0;
+      ++it)
+    {
+      fs::path exportPath = fs::path(exportDirectory) / it->first.substr(folderPrefix.length());
+      fs::create_directories(exportPath.parent_path());
+      success = UsdBridgeConnection::WriteFile(it->second.data(), it->second.size(), exportPath.string().c_str(), false) && success;
+    }
+  }
+  CONNECT_CATCH(false)
+
+  return success;
+}
@@ -7,6 +7,8 @@
 #include "UsdBridgeData.h"
 
 #include <string>
+#include <map>
+#include <vector>
 
 class UsdBridgeRemoteConnectionInternals;
 
@@ -138,5 +140,34 @@ public:
 protected:
 };
 
+// Keeps all written files in memory, keyed by their path relative from the working directory.
+class UsdBridgeMemoryConnection : public UsdBridgeConnection
+{
+public:
+  UsdBridgeMemoryConnection();
+  ~UsdBridgeMemoryConnection() override;
+
+  const char* GetBaseUrl() const override;
+  const char* GetUrl(const char* path) const override;
+
+  bool Initialize(const UsdBridgeConnectionSettings& settings,
+    const UsdBridgeLogObject& logObj) override;
+  void Shutdown() override;
+
+  int MaxSessionNr() const override;
+
+  bool CreateFolder(const char* dirName, bool isRelative, bool mayExist) const override;
+  bool RemoveFolder(const char* dirName, bool isRelative) const override;
+  bool WriteFile(const char* data, size_t dataSize, const char* filePath, bool isRelative, bool binary = true) const override;
+  bool RemoveFile(const char* filePath, bool isRelative) const override;
+
+  bool ProcessUpdates() override;
+
+  const std::vector<char>* FindFile(const char* filePath) const; // Relative from working directory, nullptr if not found
+  bool ExportFiles(const char* folderName, const char* exportDirectory) const; // Writes all files within folderName to disk, relative from exportDirectory
+
+protected:
+  mutable std::map<std::string, std::vector<char>> Files;
+};
 
 #endif
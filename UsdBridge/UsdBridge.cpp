@@ -49,6 +49,7 @@ namespace
   const char* const samplerPathRp = "samplers"; // created in material parent class (separation from other UsdShader prims in material)
   const char* const protoShapePathRp = "protoshapes"; // created in geometry parent class
   const char* const protoGeometryPathRp = "protogeometries"; // created in geometry parent class
+  const char* const instanceBatchPathRp = "instancers"; // point instancers per referenced group, created in world or instance parent class
 
   // Postfixes for prim stage names, also used for manifests
   const char* const geomPrimStagePf = "_Geom";
@@ -136,6 +137,7 @@ struct UsdBridgeInternals
 
   // Temp arrays
   UsdBridgePrimCacheList TempPrimCaches;
+  std::vector<UsdBridgeInstanceBatch> TempInstanceBatches;
   SdfPrimPathList TempPrimPaths;
   SdfPrimPathList ProtoPrimPaths;
 
@@ -293,10 +295,15 @@ void UsdBridge::SetExternalSceneStage(SceneStagePtr sceneStage)
 
 void UsdBridge::SetEnableSaving(bool enableSaving)
 {
-  this->EnableSaving = enableSaving;
+  this->EnableSaving = enableSaving && !BRIDGE_USDWRITER.IsInMemory();
   BRIDGE_USDWRITER.SetEnableSaving(enableSaving);
 }
 
+void UsdBridge::SetMaxOpenClipStages(size_t maxOpenClipStages)
+{
+  BRIDGE_USDWRITER.SetMaxOpenClipStages(maxOpenClipStages);
+}
+
 bool UsdBridge::OpenSession(UsdBridgeLogCallback logCallback, void* logUserData)
 {
   BRIDGE_USDWRITER.LogObject = {logUserData, logCallback};
@@ -454,7 +461,7 @@ bool UsdBridge::CreateGeometryTemplate(const char* name, UsdGeometryHandle& hand
   if (!cacheExists)
   {
 #ifdef VALUE_CLIP_RETIMING
-    BRIDGE_USDWRITER.CreateManifestStage(name, geomPrimStagePf, cacheEntry);
+    BRIDGE_USDWRITER.SetManifestStagePath(name, geomPrimStagePf, cacheEntry);
 
 #ifndef TIME_CLIP_STAGES
     // Default primstage created for clip assetpaths of parents. If this path is not active, individual clip stages are created lazily during data update.
@@ -497,8 +504,8 @@ bool UsdBridge::CreateSpatialField(const char * name, UsdSpatialFieldHandle& han
   if (!cacheExists)
   {
 #ifdef VALUE_CLIP_RETIMING
-    // Create manifest and primstage
-    BRIDGE_USDWRITER.CreateManifestStage(name, fieldPrimStagePf, cacheEntry);
+    // Set manifest path and create primstage
+    BRIDGE_USDWRITER.SetManifestStagePath(name, fieldPrimStagePf, cacheEntry);
 
     UsdStageRefPtr volPrimStage = BRIDGE_USDWRITER.FindOrCreatePrimStage(cacheEntry, fieldPrimStagePf).second;
     BRIDGE_USDWRITER.InitializeUsdVolume(volPrimStage, cacheEntry->PrimPath, false);
@@ -526,8 +533,8 @@ bool UsdBridge::CreateMaterial(const char* name, UsdMaterialHandle& handle)
   if (!cacheExists)
   {
 #ifdef VALUE_CLIP_RETIMING
-    // Create manifest and primstage
-    BRIDGE_USDWRITER.CreateManifestStage(name, materialPrimStagePf, matCacheEntry);
+    // Set manifest path and create primstage
+    BRIDGE_USDWRITER.SetManifestStagePath(name, materialPrimStagePf, matCacheEntry);
 
     UsdStageRefPtr matPrimStage = BRIDGE_USDWRITER.FindOrCreatePrimStage(matCacheEntry, materialPrimStagePf).second;
     BRIDGE_USDWRITER.InitializeUsdMaterial(matPrimStage, matCacheEntry->PrimPath, false);
@@ -551,8 +558,8 @@ bool UsdBridge::CreateSampler(const char* name, UsdSamplerHandle& handle, UsdBri
   if (!cacheExists)
   {
 #ifdef VALUE_CLIP_RETIMING
-    // Create manifest and primstage
-    BRIDGE_USDWRITER.CreateManifestStage(name, samplerPrimStagePf, cacheEntry);
+    // Set manifest path and create primstage
+    BRIDGE_USDWRITER.SetManifestStagePath(name, samplerPrimStagePf, cacheEntry);
 
     UsdStageRefPtr samplerPrimStage = BRIDGE_USDWRITER.FindOrCreatePrimStage(cacheEntry, samplerPrimStagePf).second;
     BRIDGE_USDWRITER.InitializeUsdSampler(samplerPrimStage, cacheEntry->PrimPath, type, false);
@@ -738,6 +745,38 @@ void UsdBridge::SetGroupRef(UsdInstanceHandle instance, UsdGroupHandle group, bo
   BRIDGE_USDWRITER.AddRef_NoClip(instanceCache, groupCache, nullptr, timeVarying, timeStep, instanceable, Internals->RefModCallbacks);
 }
 
+template<typename ParentHandleType>
+void UsdBridge::SetInstanceBatchRefs(ParentHandleType parentHandle, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep)
+{
+  if (parentHandle.value == nullptr) return;
+
+  // Batches without a group are skipped
+  UsdBridgePrimCacheList& groupCaches = Internals->TempPrimCaches;
+  std::vector<UsdBridgeInstanceBatch>& validBatches = Internals->TempInstanceBatches;
+  groupCaches.resize(0);
+  validBatches.resize(0);
+  for (uint64_t i = 0; i < numBatches; ++i)
+  {
+    if (batches[i].Group.value == nullptr) continue;
+    groupCaches.push_back(BRIDGE_CACHE.ConvertToPrimCache(batches[i].Group));
+    validBatches.push_back(batches[i]);
+  }
+
+  UsdBridgePrimCache* parentCache = BRIDGE_CACHE.ConvertToPrimCache(parentHandle);
+
+  BRIDGE_USDWRITER.UpdateUsdInstanceBatches(parentCache, groupCaches, validBatches.data(), instanceBatchPathRp, timeVarying, timeStep, Internals->RefModCallbacks);
+}
+
+void UsdBridge::SetInstanceBatches(UsdWorldHandle world, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep)
+{
+  SetInstanceBatchRefs(world, batches, numBatches, timeVarying, timeStep);
+}
+
+void UsdBridge::SetInstanceBatches(UsdInstanceHandle instance, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep)
+{
+  SetInstanceBatchRefs(instance, batches, numBatches, timeVarying, timeStep);
+}
+
 void UsdBridge::SetSurfaceRefs(UsdWorldHandle world, const UsdSurfaceHandle* surfaces, uint64_t numSurfaces, bool timeVarying, double timeStep, const int* instanceableValues)
 {
   SetNoClipRefs(world, surfaces, numSurfaces, surfacePathRp, timeVarying, timeStep, instanceableValues);
@@ -870,7 +909,7 @@ void UsdBridge::SetSamplerRefs(UsdMaterialHandle material, const UsdSamplerHandl
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    materialStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(materialStage);
 #endif
 }
 
@@ -912,6 +951,16 @@ void UsdBridge::DeleteInstanceRefs(UsdWorldHandle world, bool timeVarying, doubl
   DeleteAllRefs(world, instancePathRp, timeVarying, timeStep);
 }
 
+void UsdBridge::DeleteInstanceBatches(UsdWorldHandle world, bool timeVarying, double timeStep)
+{
+  SetInstanceBatchRefs(world, nullptr, 0, timeVarying, timeStep);
+}
+
+void UsdBridge::DeleteInstanceBatches(UsdInstanceHandle instance, bool timeVarying, double timeStep)
+{
+  SetInstanceBatchRefs(instance, nullptr, 0, timeVarying, timeStep);
+}
+
 void UsdBridge::DeleteGroupRef(UsdInstanceHandle instance, bool timeVarying, double timeStep)
 {
   DeleteAllRefs(instance, nullptr, timeVarying, timeStep);
@@ -1000,24 +1049,44 @@ void UsdBridge::SetGeometryDataTemplate(UsdGeometryHandle geometry, const GeomDa
 
   SdfPath& geomPath = cache->PrimPath;
 
+  // Time-varying members which have not changed so far are written as uniform data
+  GeomDataType splitGeomData = geomData;
+  BRIDGE_USDWRITER.SplitStaticGeometryMembers(cache, splitGeomData, timeStep);
+
 #ifdef VALUE_CLIP_RETIMING
-  if(cache->TimeVarBitsUpdate(geomData.TimeVarying))
-    BRIDGE_USDWRITER.UpdateUsdGeometryManifest(cache, geomData);
+  bool timeVarBitsChanged = cache->TimeVarBitsUpdate(splitGeomData.TimeVarying);
+  if(timeVarBitsChanged)
+    BRIDGE_USDWRITER.UpdateUsdGeometryManifest(cache, splitGeomData);
 #endif
 
+#ifdef TIME_CLIP_STAGES
+  bool clipStageInitialized = false;
+#endif
   UsdStageRefPtr geomStage = BRIDGE_USDWRITER.GetTimeVarStage(cache
 #ifdef TIME_CLIP_STAGES
     , true, geomClipPf, timeStep
-    , [usdWriter=&BRIDGE_USDWRITER, &geomPath, &geomData] (UsdStageRefPtr geomStage) 
-        { usdWriter->InitializeUsdGeometry(geomStage, geomPath, geomData, false); }
+    , [usdWriter=&BRIDGE_USDWRITER, &geomPath, &splitGeomData, &clipStageInitialized] (UsdStageRefPtr geomStage) 
+        { usdWriter->InitializeUsdGeometry(geomStage, geomPath, splitGeomData, false); clipStageInitialized = true; }
 #endif
   );
+
+#ifdef TIME_CLIP_STAGES
+  // The attributes of an existing clip stage follow the time-varying bits of its earlier update, eg. before a static member became dynamic
+  if(timeVarBitsChanged && !clipStageInitialized)
+    BRIDGE_USDWRITER.InitializeUsdGeometry(geomStage, geomPath, splitGeomData, false);
+#endif
   
-  BRIDGE_USDWRITER.UpdateUsdGeometry(geomStage, geomPath, geomData, timeStep);
+  BRIDGE_USDWRITER.UpdateUsdGeometry(geomStage, cache, splitGeomData, timeStep);
+  BRIDGE_USDWRITER.BackFillStaticGeometryMembers(geomStage, cache);
 
 #ifdef VALUE_CLIP_RETIMING
-  if(this->EnableSaving)
-    geomStage->Save();
+#ifdef TIME_CLIP_STAGES
+  bool saveGeomStage = !BRIDGE_USDWRITER.Settings.PackClipStages; // Packed clip stages hold all geometries of a timestep, so they are saved when the timestep is finalized or with the scene
+#else
+  bool saveGeomStage = true;
+#endif
+  if(this->EnableSaving && saveGeomStage)
+    BRIDGE_USDWRITER.SaveTimeVarStage(geomStage);
 #endif
 }
 
@@ -1054,7 +1123,7 @@ void UsdBridge::SetSpatialFieldData(UsdSpatialFieldHandle field, const UsdBridge
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    volumeStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(volumeStage);
 #endif
 }
 
@@ -1077,7 +1146,7 @@ void UsdBridge::SetMaterialData(UsdMaterialHandle material, const UsdBridgeMater
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    materialStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(materialStage);
 #endif
 }
 
@@ -1098,7 +1167,7 @@ void UsdBridge::SetSamplerData(UsdSamplerHandle sampler, const UsdBridgeSamplerD
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    samplerStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(samplerStage);
 #endif
 }
 
@@ -1123,7 +1192,7 @@ void UsdBridge::SetLightDataTemplate(UsdLightHandle light, const LightDataType&
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    lightStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(lightStage);
 #endif
 }
 
@@ -1162,7 +1231,7 @@ void UsdBridge::SetCameraData(UsdCameraHandle camera, const UsdBridgeCameraData&
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    cameraStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(cameraStage);
 #endif
 }
 
@@ -1211,7 +1280,7 @@ void UsdBridge::ChangeInAttribute(UsdSamplerHandle sampler, const char* newName,
 
 #ifdef VALUE_CLIP_RETIMING
   if(this->EnableSaving)
-    samplerStage->Save();
+    BRIDGE_USDWRITER.SaveTimeVarStage(samplerStage);
 #endif
 }
 
@@ -1222,6 +1291,60 @@ void UsdBridge::SaveScene()
   BRIDGE_USDWRITER.SaveScene();
 }
 
+bool UsdBridge::ExportScene(const char* exportDirectory)
+{
+  if (!SessionValid) return false;
+
+  return BRIDGE_USDWRITER.ExportScene(exportDirectory);
+}
+
+bool UsdBridge::FindInMemoryFile(const char* assetPath, const void*& data, size_t& dataSize) const
+{
+  if (!SessionValid) return false;
+
+  const std::vector<char>* fileData = BRIDGE_USDWRITER.FindInMemoryFile(assetPath);
+  if (!fileData)
+    return false;
+
+  data = fileData->data();
+  dataSize = fileData->size();
+  return true;
+}
+
+void UsdBridge::FinalizeTimeStepsBefore(double timeStep)
+{
+  if (!SessionValid) return;
+
+  BRIDGE_CACHE.FinalizeTimeStepsBefore(timeStep);
+#ifdef TIME_CLIP_STAGES
+  BRIDGE_USDWRITER.DropClipStageHandlesBefore(timeStep);
+#endif
+  BRIDGE_USDWRITER.SaveScene();
+}
+
+void UsdBridge::FlushClipMetaData()
+{
+  if (!SessionValid) return;
+
+#ifdef VALUE_CLIP_RETIMING
+  BRIDGE_USDWRITER.FlushClipMetaData();
+#endif
+}
+
+void UsdBridge::BeginEditBatch()
+{
+  if (!SessionValid) return;
+
+  BRIDGE_USDWRITER.BeginEditBatch();
+}
+
+void UsdBridge::EndEditBatch()
+{
+  if (!SessionValid) return;
+
+  BRIDGE_USDWRITER.EndEditBatch();
+}
+
 // =============================================================================
 // Multi-frame rendering API
 // =============================================================================
@@ -21,6 +21,7 @@ class UsdBridge
 
     void SetExternalSceneStage(SceneStagePtr sceneStage);
     void SetEnableSaving(bool enableSaving);
+    void SetMaxOpenClipStages(size_t maxOpenClipStages); // Clip stages beyond this number are saved and closed, least recently used first (0 is unbounded)
   
     bool OpenSession(UsdBridgeLogCallback logCallback, void* logUserData);
     bool GetSessionValid() const { return SessionValid; }
@@ -54,6 +55,8 @@ class UsdBridge
   
     void SetInstanceRefs(UsdWorldHandle world, const UsdInstanceHandle* instances, uint64_t numInstances, bool timeVarying, double timeStep, const int* instanceableValues);
     void SetGroupRef(UsdInstanceHandle instance, UsdGroupHandle group, bool timeVarying, double timeStep);
+    void SetInstanceBatches(UsdWorldHandle world, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep); // One point instancer per group, instead of a prim per instance
+    void SetInstanceBatches(UsdInstanceHandle instance, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep); // For instances with multiple transforms
     void SetSurfaceRefs(UsdWorldHandle world, const UsdSurfaceHandle* surfaces, uint64_t numSurfaces, bool timeVarying, double timeStep, const int* instanceableValues);
     void SetSurfaceRefs(UsdGroupHandle group, const UsdSurfaceHandle* surfaces, uint64_t numSurfaces, bool timeVarying, double timeStep, const int* instanceableValues);
     void SetVolumeRefs(UsdWorldHandle world, const UsdVolumeHandle* volumes, uint64_t numVolumes, bool timeVarying, double timeStep, const int* instanceableValues);
@@ -67,6 +70,8 @@ class UsdBridge
     void SetPrototypeRefs(UsdGeometryHandle geometry, const UsdGeometryHandle* protoGeometries, size_t numProtoGeometries, double timeStep, double* protoTimeSteps);
   
     void DeleteInstanceRefs(UsdWorldHandle world, bool timeVarying, double timeStep);
+    void DeleteInstanceBatches(UsdWorldHandle world, bool timeVarying, double timeStep);
+    void DeleteInstanceBatches(UsdInstanceHandle instance, bool timeVarying, double timeStep);
     void DeleteGroupRef(UsdInstanceHandle instance, bool timeVarying, double timeStep);
     void DeleteSurfaceRefs(UsdWorldHandle world, bool timeVarying, double timeStep);
     void DeleteSurfaceRefs(UsdGroupHandle group, bool timeVarying, double timeStep);
@@ -98,6 +103,12 @@ class UsdBridge
     void ChangeInAttribute(UsdSamplerHandle sampler, const char* newName, double timeStep, SamplerDMI timeVarying);
   
     void SaveScene();
+    bool ExportScene(const char* exportDirectory); // Writes the flattened scene and all its files to exportDirectory
+    bool FindInMemoryFile(const char* assetPath, const void*& data, size_t& dataSize) const; // With in-memory output, finds a file written for an asset path of the scene
+    void FinalizeTimeStepsBefore(double timeStep); // Saves and evicts per-timestep data before timeStep, for producers which never revisit earlier timesteps
+    void FlushClipMetaData(); // Writes the clip tables changed since the last flush to the scene stage, without saving
+    void BeginEditBatch(); // Defers the attribute value edits and stage saves of all updates until EndEditBatch(), to process their changes at once
+    void EndEditBatch();
 
     // Multi-frame rendering API
     void RegisterFrame(const char* frameName);
@@ -140,6 +151,9 @@ class UsdBridge
     void SetNoClipRefs(ParentHandleType parentHandle, const ChildHandleType* childHandles, uint64_t numChildren, 
       const char* refPathExt, bool timeVarying, double timeStep, const int* instanceableValues = nullptr);
 
+    template<typename ParentHandleType>
+    void SetInstanceBatchRefs(ParentHandleType parentHandle, const UsdBridgeInstanceBatch* batches, uint64_t numBatches, bool timeVarying, double timeStep);
+
     template<typename ParentHandleType>
     void DeleteAllRefs(ParentHandleType parentHandle, const char* refPathExt, bool timeVarying, double timeStep);
 
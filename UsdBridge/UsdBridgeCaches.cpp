@@ -64,6 +64,64 @@ bool UsdBridgePrimCache::SetChildInvisibleAtTime(const UsdBridgePrimCache* child
 }
 #endif
 
+void UsdBridgePrimCache::FinalizeTimeStepsBefore(double timeStep)
+{
+#ifdef TIME_BASED_CACHING
+  // Finalized times are not made invisible anymore, so a single one of them keeps the visible set of a child non-empty
+  for(std::vector<double>& visibleTimes : ChildVisibleAtTimes)
+  {
+    bool hasFinalized = false;
+    double lastFinalized = 0.0;
+    auto newEnd = std::remove_if(visibleTimes.begin(), visibleTimes.end(), 
+      [timeStep, &hasFinalized, &lastFinalized](double visibleTime) -> bool
+      {
+        if(visibleTime >= timeStep)
+          return false;
+        lastFinalized = hasFinalized ? std::max(lastFinalized, visibleTime) : visibleTime;
+        hasFinalized = true;
+        return true;
+      });
+    visibleTimes.erase(newEnd, visibleTimes.end());
+    if(hasFinalized)
+      visibleTimes.push_back(lastFinalized);
+  }
+#endif
+
+#ifndef TIME_CLIP_STAGES
+  if(TopologyCache)
+  {
+    // Later timesteps can only share the last authored sample before timeStep
+    UsdBridgeTopologyCache::SampleContainer& samples = TopologyCache->Samples;
+    auto endIt = samples.lower_bound(timeStep);
+    auto lastAuthoredIt = endIt;
+    for(auto it = samples.begin(); it != endIt; ++it)
+    {
+      if(it->second.Authored)
+        lastAuthoredIt = it;
+    }
+    if(lastAuthoredIt != endIt)
+    {
+      samples.erase(samples.begin(), lastAuthoredIt);
+      samples.erase(std::next(lastAuthoredIt), endIt);
+    }
+    else
+      samples.erase(samples.begin(), endIt);
+  }
+#endif
+
+  if(ArraySampleCache)
+  {
+    // Later timesteps only compare against their direct neighbours, of which the last entry before timeStep is kept
+    for(auto& attribSamples : ArraySampleCache->Samples)
+    {
+      UsdBridgeArraySampleCache::SampleContainer& samples = attribSamples.second;
+      auto endIt = samples.lower_bound(timeStep);
+      if(endIt != samples.begin())
+        samples.erase(samples.begin(), std::prev(endIt));
+    }
+  }
+}
+
 #ifdef VALUE_CLIP_RETIMING
 const UsdStagePair& UsdBridgePrimCache::GetPrimStagePair() const
 {
@@ -179,6 +237,12 @@ void UsdBridgePrimCacheManager::RemovePrimCache(ConstPrimCacheIterator it, UsdBr
   UsdPrimCaches.erase(it); 
 }
 
+void UsdBridgePrimCacheManager::FinalizeTimeStepsBefore(double timeStep)
+{
+  for(auto& primCacheEntry : UsdPrimCaches)
+    primCacheEntry.second->FinalizeTimeStepsBefore(timeStep);
+}
+
 void UsdBridgePrimCacheManager::RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove)
 {
   // First recursively remove all the child references for unreferenced prims
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -51,6 +52,87 @@ struct UsdBridgeResourceKey
   }
 };
 
+// Topology hash per timestep of a time-varying mesh, to share samples of unchanged topology between timesteps.
+// Timesteps which share an earlier sample are kept as non-authored entries.
+struct UsdBridgeTopologyCache
+{
+  struct TopologySample
+  {
+    uint64_t Hash;
+    bool Authored;
+  };
+  using SampleContainer = std::map<double, TopologySample>;
+
+  SampleContainer Samples;
+  SdfPath PrimPath; // Mesh prim the samples have been written to
+};
+
+// Samples per timestep of time-varying arrays with linear interpolation (usd::timeSampleSharing), keyed by attribute path.
+// Timesteps which resolve to their own contents without a sample, as both of their neighbours hold the same contents, are kept as non-authored entries.
+// Time-varying members which have not changed since they were first written are kept as uniform data, keyed by their DataMemberId bit
+// (mesh topology always, the other members with usd::timeSampleSharing).
+struct UsdBridgeArraySampleCache
+{
+  using SampleContents = std::shared_ptr<const std::vector<char>>;
+
+  struct ArraySample
+  {
+    uint64_t Hash = 0;
+    size_t Size = 0; // Number of source bytes
+    bool Blocked = false; // Value block, without contents
+    bool Authored = false;
+    SampleContents Contents; // Source bytes, compared on equal hashes and shared between samples with equal contents. Only kept around the most recently written entry; absent for samples compared by hash and size only.
+  };
+  using SampleContainer = std::map<double, ArraySample>;
+
+  struct StaticMember
+  {
+    ArraySample Sample;
+    std::vector<double> TimeSteps; // Written while the member was uniform, so its value has to be authored there once it changes
+    bool Dynamic = false;
+  };
+
+  struct BackFill
+  {
+    UsdAttribute UniformAttrib;
+    VtValue Value;
+    std::vector<double> TimeSteps;
+  };
+
+  std::map<SdfPath, SampleContainer> Samples;
+  std::map<uint32_t, StaticMember> StaticMembers;
+  std::vector<BackFill> BackFills; // Uniform values of members which have become dynamic, authored after the update
+};
+
+#ifdef TIME_BASED_CACHING
+// Reference elements of a mesh with time-varying members and usd::timeSampleSharing, compared by hash per vertex and per face.
+// The static prim of the mesh holds the reference elements as uniform data and hides the faces which differ from them at a timestep,
+// which the dynamic prim holds instead. Without correspondence to the reference, eg. after a change in the number of vertices, all faces are dynamic.
+struct UsdBridgeMeshElementCache
+{
+  uint64_t LayoutHash = 0; // Numbers of vertices and faces, and the types and interpolations of the time-varying members
+  uint64_t NumFaces = 0;
+  std::vector<uint64_t> VertexHashes;
+  std::vector<uint64_t> FaceHashes;
+};
+#endif
+
+#ifdef VALUE_CLIP_RETIMING
+// Clip metadata of a single value-clipped referencing prim, indexed by parent timestep.
+// Updates are kept in memory and only written to the clip metadata of the prim when flushed by the writer.
+struct UsdBridgeClipTable
+{
+  std::map<double, double> ClipTimes; // Parent timestep to child timestep
+  std::map<double, int> ClipActives; // Parent timestep to index into AssetPaths
+  std::vector<std::string> AssetPaths;
+  std::unordered_map<std::string, int> AssetIndices; // Inverse of AssetPaths
+  std::vector<int> AssetUseCounts; // Number of ClipActives entries per index into AssetPaths
+  SdfPath ClipPrimPath; // Path of the clipped child prim
+  std::string ManifestPath;
+  bool Dirty = false;
+};
+#endif
+
 struct UsdBridgeRefCache
 {
 public:
@@ -81,12 +163,21 @@ public:
   ResourceCollectFunc ResourceCollect;
 
   std::unique_ptr<ResourceContainer> ResourceKeys; // Referenced resources
+#ifndef TIME_CLIP_STAGES
+  std::unique_ptr<UsdBridgeTopologyCache> TopologyCache; // Only for time-varying mesh topology, which clip stages write per timestep
+#endif
+  std::unique_ptr<UsdBridgeArraySampleCache> ArraySampleCache; // Only for time-varying geometry arrays with usd::timeSampleSharing, or time-varying mesh topology
+#ifdef TIME_BASED_CACHING
+  std::unique_ptr<UsdBridgeMeshElementCache> MeshElementCache; // Only for meshes with time-varying members and usd::timeSampleSharing
+#endif
 
 #ifdef TIME_BASED_CACHING
   void SetChildVisibleAtTime(const UsdBridgePrimCache* childCache, double timeCode);
   bool SetChildInvisibleAtTime(const UsdBridgePrimCache* childCache, double timeCode); // Returns whether timeCode has been removed AND the visible timeset is empty.
 #endif
 
+  void FinalizeTimeStepsBefore(double timeStep); // Drops time-indexed entries which only matter when revisiting timesteps before timeStep
+
 #ifdef VALUE_CLIP_RETIMING
   static constexpr double PrimStageTimeCode = 0.0; // Prim stages are stored in ClipStages under specified time code
   const UsdStagePair& GetPrimStagePair() const;
@@ -96,8 +187,14 @@ public:
 
   UsdStagePair ManifestStage; // Holds the manifest
   std::unordered_map<double, UsdStagePair> ClipStages; // Holds the stage(s) to the timevarying data
+#ifdef TIME_CLIP_STAGES
+  std::vector<double> PackedClipTimeSteps; // Sorted timesteps of the packed clip stages which contain this prim
+#endif
 
   uint32_t LastTimeVaryingBits = 0; // Used to detect changes in timevarying status of parameters
+
+  using ClipTableContainer = std::map<SdfPath, UsdBridgeClipTable>;
+  std::unique_ptr<ClipTableContainer> ClipTables; // Only for prims referencing value-clipped children, keyed by referencing prim path
 #endif
 
 #ifndef NDEBUG
@@ -141,6 +238,7 @@ public:
   ConstPrimCacheIterator CreatePrimCache(const std::string& name, const std::string& fullPath, ResourceCollectFunc collectFunc = nullptr);
   void RemovePrimCache(ConstPrimCacheIterator it, UsdBridgeLogObject& LogObject);
   void RemoveUnreferencedPrimCaches(AtRemoveFunc atRemove);
+  void FinalizeTimeStepsBefore(double timeStep);
 
   void AddChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child);
   void RemoveChild(UsdBridgePrimCache* parent, UsdBridgePrimCache* child);
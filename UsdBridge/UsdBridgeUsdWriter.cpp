@@ -8,6 +8,7 @@
 #include "UsdBridgeDiagnosticMgrDelegate.h"
 #include "Common/UsdBridgeParallelController.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <typeinfo>
 
@@ -33,6 +34,8 @@ namespace constring
   const char* const sessionPf = "Session_";
   const char* const rootClassName = "/RootClass";
   const char* const rootPrimName = "/Root";
+  const char* const packedClipName = "PackedClip_";
+  const char* const emptyManifestName = "EmptyManifest";
 
   const char* const manifestFolder = "manifests/";
   const char* const clipFolder = "clips/";
@@ -55,12 +58,19 @@ namespace constring
   const char* const mdlGraphWPrimPf = "_w";
   const char* const openVDBPrimPf = "ovdbfield";
   const char* const protoShapePf = "proto_";
+  const char* const protoShapeLibraryName = "protoshapes";
+  const char* const staticElementsPrimPf = "staticelements";
+  const char* const dynamicElementsPrimPf = "dynamicelements";
+
+  const char* const lodVariantSetName = "lod";
+  const char* const lodFullVariantName = "full";
 
   const char* const imageExtension = ".png";
   const char* const vdbExtension = ".vdb";
 
   const char* const fullSceneNameBin = "FullScene.usd";
   const char* const fullSceneNameAscii = "FullScene.usda";
+  const char* const memoryOutputDir = "memory/"; // Output location for in-memory output, after formatting as directory
 
   const char* const parallelSceneNameBin = "ParallelScene.usda";
   const char* const parallelSceneNameAscii = "ParallelScene.usda";
@@ -150,7 +160,7 @@ namespace
 }
 #endif
 
-#define PROCESS_PREFIX(elem) AttributeTokens.push_back(UsdBridgeTokens->elem); // Converts any token sequence macro to add all tokens to list
+#define PROCESS_PREFIX(elem) AttributeTokens.emplace(UsdBridgeTokens->elem.GetString(), UsdBridgeTokens->elem); // Converts any token sequence macro to add all tokens to list
 
 UsdBridgeUsdWriter::UsdBridgeUsdWriter(const UsdBridgeSettings& settings)
   : Settings(settings)
@@ -179,15 +189,90 @@ void UsdBridgeUsdWriter::SetExternalSceneStage(UsdStageRefPtr sceneStage)
 
 void UsdBridgeUsdWriter::SetEnableSaving(bool enableSaving)
 {
-  this->EnableSaving = enableSaving;
+  this->EnableSaving = enableSaving && !IsInMemory(); // Anonymous layers cannot be saved
+}
+
+bool UsdBridgeUsdWriter::IsInMemory() const
+{
+  return ConnectionSettings.HostName.empty() && ConnectionSettings.WorkingDirectory.compare(constring::memoryOutputDir) == 0;
+}
+
+void UsdBridgeUsdWriter::SetMaxOpenClipStages(size_t maxOpenClipStages)
+{
+#ifdef TIME_CLIP_STAGES
+  this->MaxOpenClipStages = maxOpenClipStages;
+  DropClipStageHandles();
+#endif
 }
 
 void UsdBridgeUsdWriter::SaveScene()
 {
+#ifdef VALUE_CLIP_RETIMING
+  FlushClipMetaData();
+  SaveManifestStages();
+#endif
+#ifdef TIME_CLIP_STAGES
+  SavePackedClipStages();
+#endif
+
+  UsdBridgeSdfEditBatch::FlushActive(); // Including the saves deferred by the calls above
+
   if(this->EnableSaving)
     this->SceneStage->Save();
 }
 
+void UsdBridgeUsdWriter::SaveTimeVarStage(const UsdStageRefPtr& stage) const
+{
+  if(!UsdBridgeSdfEditBatch::AddSave(stage))
+    stage->GetRootLayer()->Save();
+}
+
+void UsdBridgeUsdWriter::BeginEditBatch()
+{
+  if(!this->EditBatch)
+    this->EditBatch = std::make_unique<UsdBridgeSdfEditBatch>();
+}
+
+void UsdBridgeUsdWriter::EndEditBatch()
+{
+  this->EditBatch.reset(); // Flushes the batch
+}
+
+bool UsdBridgeUsdWriter::ExportScene(const char* exportDirectory)
+{
+#ifdef VALUE_CLIP_RETIMING
+  FlushClipMetaData();
+#endif
+
+  std::string exportDir(exportDirectory);
+  FormatDirName(exportDir);
+  std::string exportSceneFile = exportDir + (this->Settings.BinaryOutput ? constring::fullSceneNameBin : constring::fullSceneNameAscii);
+
+  UsdBridgeSdfEditBatch::FlushActive();
+
+  // Flattening composes the prim, manifest and clip stages into a single layer, whether anonymous or not
+  SdfLayerRefPtr flattenedLayer = this->SceneStage->Flatten();
+  bool success = flattenedLayer && flattenedLayer->Export(exportSceneFile);
+
+  // Files written to the in-memory connection, such as images and volumes, keep their paths relative from the scene
+  if (IsInMemory())
+    success = static_cast<const UsdBridgeMemoryConnection*>(Connect.get())->ExportFiles(SessionDirectory.c_str(), exportDir.c_str()) && success;
+
+  if (!success)
+  {
+    UsdBridgeLogMacro(this->LogObject, UsdBridgeLogLevel::ERR, "Scene export to " << exportSceneFile << " failed.");
+  }
+
+  return success;
+}
+
+const std::vector<char>* UsdBridgeUsdWriter::FindInMemoryFile(const char* assetPath) const
+{
+  if (!IsInMemory())
+    return nullptr;
+  return static_cast<const UsdBridgeMemoryConnection*>(Connect.get())->FindFile((SessionDirectory + assetPath).c_str());
+}
+
 int UsdBridgeUsdWriter::FindSessionNumber()
 {
   int sessionNr = Connect->MaxSessionNr();
@@ -288,6 +373,8 @@ bool UsdBridgeUsdWriter::InitializeSession()
   {
     if(ConnectionSettings.WorkingDirectory.compare("void") == 0)
       Connect = std::make_unique<UsdBridgeVoidConnection>();
+    else if(IsInMemory())
+      Connect = std::make_unique<UsdBridgeMemoryConnection>();
     else
       Connect = std::make_unique<UsdBridgeLocalConnection>();
   }
@@ -349,14 +436,34 @@ bool UsdBridgeUsdWriter::InitializeSession()
 
 void UsdBridgeUsdWriter::ResetSession()
 {
+#ifdef VALUE_CLIP_RETIMING
+  FlushClipMetaData();
+  SaveManifestStages();
+  this->UnsavedManifestCaches.clear();
+  this->ClipTableCaches.clear();
+  this->EmptyManifestStage = UsdStagePair();
+  this->EmptyManifestUnsaved = false;
+#endif
+#ifdef TIME_CLIP_STAGES
+  SavePackedClipStages();
+#endif
+  UsdBridgeSdfEditBatch::FlushActive(); // Before the session's stages are released
+
   this->SessionNumber = -1;
   this->SceneStage = nullptr;
+  this->InstancerLibraryShapes.clear();
+  this->LibraryShapeRefCounts.clear();
+#ifdef TIME_CLIP_STAGES
+  this->OpenClipStages.clear();
+  this->OpenClipStageEntries.clear();
+  this->PackedClipStages.clear();
+#endif
   this->MpiBaseSessionDirectory.clear();
 }
 
 void UsdBridgeUsdWriter::CreateParallelEncapsulatingFile()
 {
-  if(Settings.MpiRank != 0 || Settings.MpiSize <= 0)
+  if(Settings.MpiRank != 0 || Settings.MpiSize <= 0 || IsInMemory()) // The rank stages are not accessible to each other in memory
     return;
 
   bool binary = Settings.BinaryOutput;
@@ -412,6 +519,8 @@ bool UsdBridgeUsdWriter::OpenSceneStage()
 #endif
 
   const char* absSceneFile = Connect->GetUrl(this->SceneFileName.c_str());
+  if (!this->SceneStage && IsInMemory())
+    this->SceneStage = UsdStage::CreateInMemory(this->SceneFileName);
   if (!this->SceneStage && !Settings.CreateNewSession)
       this->SceneStage = UsdStage::Open(absSceneFile);
   if (!this->SceneStage)
@@ -497,24 +606,88 @@ UsdStageRefPtr UsdBridgeUsdWriter::GetTimeVarStage(UsdBridgePrimCache* cache
 }
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::CreateManifestStage(const char* name, const char* primPostfix, UsdBridgePrimCache* cacheEntry)
+void UsdBridgeUsdWriter::SetManifestStagePath(const char* name, const char* primPostfix, UsdBridgePrimCache* cacheEntry)
 {
   bool binary = this->Settings.BinaryOutput;
 
   cacheEntry->ManifestStage.first = constring::manifestFolder + std::string(name) + primPostfix + (binary ? ".usd" : ".usda");
+}
+
+const UsdStagePair& UsdBridgeUsdWriter::FindOrCreateManifestStage(UsdBridgePrimCache* cacheEntry)
+{
+  // Callers author to the manifest, so it has to be saved either way
+  this->UnsavedManifestCaches.insert(cacheEntry);
+
+  UsdStagePair& manifestStage = cacheEntry->ManifestStage;
+  if (manifestStage.second)
+    return manifestStage;
+
+  // Clip metadata of prims referencing this one still points to the empty manifest
+  this->NewManifestCaches.insert(cacheEntry);
+
+  CreateManifestStage(manifestStage);
+
+  return manifestStage;
+}
+
+const std::string& UsdBridgeUsdWriter::GetClipManifestPath(UsdBridgePrimCache* childCache)
+{
+  if (childCache->ManifestStage.second)
+    return childCache->ManifestStage.first;
+
+  // Children without time-varying data share a single empty manifest, until they receive one of their own
+  if (!this->EmptyManifestStage.second)
+  {
+    bool binary = this->Settings.BinaryOutput;
+    this->EmptyManifestStage.first = constring::manifestFolder + std::string(constring::emptyManifestName) + (binary ? ".usd" : ".usda");
+
+    CreateManifestStage(this->EmptyManifestStage);
+    this->EmptyManifestUnsaved = true;
+  }
+
+  return this->EmptyManifestStage.first;
+}
 
-  std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + cacheEntry->ManifestStage.first).c_str());
+void UsdBridgeUsdWriter::CreateManifestStage(UsdStagePair& manifestStage)
+{
+  assert(!manifestStage.first.empty());
 
-  UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(false);
-  cacheEntry->ManifestStage.second = UsdStage::CreateNew(absoluteFileName);
-  UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(true);
+  if (IsInMemory())
+  {
+    manifestStage.second = UsdStage::CreateInMemory(manifestStage.first);
+    manifestStage.first = manifestStage.second->GetRootLayer()->GetIdentifier(); // Anonymous layers are referred to by identifier
+  }
+  else
+  {
+    std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + manifestStage.first).c_str());
 
-  if (!cacheEntry->ManifestStage.second)
-    cacheEntry->ManifestStage.second = UsdStage::Open(absoluteFileName);
+    UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(false);
+    manifestStage.second = UsdStage::CreateNew(absoluteFileName);
+    UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(true);
+
+    if (!manifestStage.second)
+      manifestStage.second = UsdStage::Open(absoluteFileName);
+  }
 
-  assert(cacheEntry->ManifestStage.second);
+  assert(manifestStage.second);
 
-  cacheEntry->ManifestStage.second->DefinePrim(SdfPath(this->RootClassName));
+  manifestStage.second->DefinePrim(SdfPath(this->RootClassName));
+}
+
+void UsdBridgeUsdWriter::SaveManifestStages()
+{
+  if (!this->EnableSaving)
+    return; // Kept until saving is enabled again
+
+  for (UsdBridgePrimCache* cacheEntry : UnsavedManifestCaches)
+    SaveTimeVarStage(cacheEntry->ManifestStage.second);
+  UnsavedManifestCaches.clear();
+
+  if (EmptyManifestUnsaved)
+  {
+    SaveTimeVarStage(EmptyManifestStage.second);
+    EmptyManifestUnsaved = false;
+  }
 }
 
 void UsdBridgeUsdWriter::RemoveManifestAndClipStages(const UsdBridgePrimCache* cacheEntry)
@@ -529,6 +702,11 @@ void UsdBridgeUsdWriter::RemoveManifestAndClipStages(const UsdBridgePrimCache* c
     Connect->RemoveFile((SessionDirectory + cacheEntry->ManifestStage.first).c_str(), true);
   }
 
+#ifdef TIME_CLIP_STAGES
+  RemoveClipStagesFromPool(cacheEntry);
+  RemoveFromPackedClipStages(cacheEntry);
+#endif
+
   // remove all clipstage files
   for (auto& x : cacheEntry->ClipStages)
   {
@@ -544,6 +722,10 @@ const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimStage(UsdBridgePrimCache
 
 const UsdStagePair& UsdBridgeUsdWriter::FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists) const
 {
+#ifdef TIME_CLIP_STAGES
+  if (this->Settings.PackClipStages)
+    return FindOrCreatePackedClipStage(cacheEntry, timeStep, exists);
+#endif
   return FindOrCreatePrimClipStage(cacheEntry, namePostfix, true, timeStep, exists);
 }
 
@@ -564,35 +746,232 @@ const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePrimClipStage(UsdBridgePrimC
       fullNamePostfix += std::to_string(timeStep); 
     }
     std::string relativeFileName = folder + cacheEntry->Name.GetString() + fullNamePostfix + (binary ? ".usd" : ".usda");
-    std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + relativeFileName).c_str());
 
+    it = cacheEntry->ClipStages.emplace(timeStep, CreateOrOpenTimeVarStage(std::move(relativeFileName), exists)).first;
+  }
+  else if (!it->second.second)
+  {
+    ReopenTimeVarStage(it->second);
+  }
+
+#ifdef TIME_CLIP_STAGES
+  if (isClip)
+    TouchClipStage(cacheEntry, timeStep);
+#endif
+
+  return it->second;
+}
+
+UsdStagePair UsdBridgeUsdWriter::CreateOrOpenTimeVarStage(std::string relativeFileName, bool& exists) const
+{
+  std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + relativeFileName).c_str());
+
+  UsdStageRefPtr timeVarStage;
+  if (IsInMemory())
+  {
+    timeVarStage = UsdStage::CreateInMemory(relativeFileName);
+    relativeFileName = timeVarStage->GetRootLayer()->GetIdentifier(); // Anonymous layers are referred to by identifier
+  }
+  else
+  {
     UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(false);
-    UsdStageRefPtr primClipStage = UsdStage::CreateNew(absoluteFileName);
+    timeVarStage = UsdStage::CreateNew(absoluteFileName);
     UsdBridgeDiagnosticMgrDelegate::SetOutputEnabled(true);
+  }
+
+  exists = !timeVarStage;
+
+  SdfPath rootPrimPath(this->RootClassName);
+  if (exists)
+  {
+    timeVarStage = UsdStage::Open(absoluteFileName); //Could happen if written folder is reused 
+    assert(timeVarStage->GetPrimAtPath(rootPrimPath));
+  }
+  else
+    timeVarStage->DefinePrim(rootPrimPath);
+
+  return UsdStagePair(std::move(relativeFileName), timeVarStage);
+}
+
+void UsdBridgeUsdWriter::ReopenTimeVarStage(UsdStagePair& stagePair) const
+{
+  // Released by the clip stage pool, so it has been saved before
+  std::string absoluteFileName = Connect->GetUrl((this->SessionDirectory + stagePair.first).c_str());
+  stagePair.second = UsdStage::Open(absoluteFileName);
+  assert(stagePair.second);
+}
+#endif
+
+#ifdef TIME_CLIP_STAGES
+void UsdBridgeUsdWriter::TouchClipStage(UsdBridgePrimCache* cacheEntry, double timeStep) const
+{
+  ClipStageKey key(cacheEntry, timeStep);
+  auto entryIt = OpenClipStageEntries.find(key);
+  if (entryIt != OpenClipStageEntries.end())
+    OpenClipStages.splice(OpenClipStages.begin(), OpenClipStages, entryIt->second);
+  else
+  {
+    OpenClipStages.push_front(key);
+    OpenClipStageEntries.emplace(key, OpenClipStages.begin());
+  }
+
+  DropClipStageHandles();
+}
+
+void UsdBridgeUsdWriter::DropClipStageHandles() const
+{
+  // Without saving, the contents of a released stage would be lost
+  if (!this->EnableSaving || this->MaxOpenClipStages == 0)
+    return;
+
+  // The most recently used stage is at the front and never released, so references returned by FindOrCreateClipStage() stay valid
+  while (OpenClipStages.size() > this->MaxOpenClipStages)
+    DropClipStageHandle(std::prev(OpenClipStages.end()));
+}
+
+void UsdBridgeUsdWriter::DropClipStageHandlesBefore(double timeStep)
+{
+  if (!this->EnableSaving)
+    return;
 
-    exists = !primClipStage;
+  // Packed stages are not saved after each geometry update, so they are written out here once their timestep is final
+  for (auto& x : PackedClipStages)
+  {
+    if (x.first >= timeStep || !x.second.second)
+      continue;
 
-    SdfPath rootPrimPath(this->RootClassName);
-    if (exists)
+    auto entryIt = OpenClipStageEntries.find(ClipStageKey(nullptr, x.first));
+    if (entryIt != OpenClipStageEntries.end())
+      DropClipStageHandle(entryIt->second);
+    else
     {
-      primClipStage = UsdStage::Open(absoluteFileName); //Could happen if written folder is reused 
-      assert(primClipStage->GetPrimAtPath(rootPrimPath));
+      SaveTimeVarStage(x.second.second);
+      x.second.second = nullptr;
     }
-    else
-      primClipStage->DefinePrim(rootPrimPath);
+  }
+
+  for (auto listIt = OpenClipStages.begin(); listIt != OpenClipStages.end(); )
+  {
+    auto nextIt = std::next(listIt);
+    if (listIt->second < timeStep)
+      DropClipStageHandle(listIt);
+    listIt = nextIt;
+  }
+}
+
+void UsdBridgeUsdWriter::DropClipStageHandle(ClipStageList::iterator listIt) const
+{
+  ClipStageKey key = *listIt;
+  OpenClipStages.erase(listIt);
+  OpenClipStageEntries.erase(key);
+
+  std::unordered_map<double, UsdStagePair>& clipStages = key.first ? key.first->ClipStages : PackedClipStages;
+  auto it = clipStages.find(key.second);
+  if (it != clipStages.end() && it->second.second)
+  {
+    SaveTimeVarStage(it->second.second);
+    it->second.second = nullptr; // Only the bridge-side handle; layers opened by the scene's value clips stay loaded with the scene stage
+  }
+}
+
+void UsdBridgeUsdWriter::RemoveClipStagesFromPool(const UsdBridgePrimCache* cacheEntry)
+{
+  for (const auto& x : cacheEntry->ClipStages)
+  {
+    auto entryIt = OpenClipStageEntries.find(ClipStageKey(const_cast<UsdBridgePrimCache*>(cacheEntry), x.first));
+    if (entryIt != OpenClipStageEntries.end())
+    {
+      OpenClipStages.erase(entryIt->second);
+      OpenClipStageEntries.erase(entryIt);
+    }
+  }
+}
+
+const UsdStagePair& UsdBridgeUsdWriter::FindOrCreatePackedClipStage(UsdBridgePrimCache* cacheEntry, double timeStep, bool& exists) const
+{
+  bool binary = this->Settings.BinaryOutput;
 
-    it = cacheEntry->ClipStages.emplace(timeStep, UsdStagePair(std::move(relativeFileName), primClipStage)).first;
+  auto it = PackedClipStages.find(timeStep);
+  if (it == PackedClipStages.end())
+  {
+    std::string relativeFileName = constring::clipFolder + std::string(constring::packedClipName) + std::to_string(timeStep) + (binary ? ".usd" : ".usda");
+
+    bool stageExists;
+    it = PackedClipStages.emplace(timeStep, CreateOrOpenTimeVarStage(std::move(relativeFileName), stageExists)).first;
+  }
+  else if (!it->second.second)
+  {
+    ReopenTimeVarStage(it->second);
   }
+
+  TouchClipStage(nullptr, timeStep);
+
+  // The stage is shared, so existence refers to the prim within it
+  exists = static_cast<bool>(it->second.second->GetPrimAtPath(cacheEntry->PrimPath));
+
+  std::vector<double>& packedTimeSteps = cacheEntry->PackedClipTimeSteps;
+  auto timeIt = std::lower_bound(packedTimeSteps.begin(), packedTimeSteps.end(), timeStep);
+  if (timeIt == packedTimeSteps.end() || *timeIt != timeStep)
+    packedTimeSteps.insert(timeIt, timeStep);
+
   return it->second;
 }
+
+const UsdStagePair* UsdBridgeUsdWriter::FindClipStage(UsdBridgePrimCache* cacheEntry, double timeStep) const
+{
+  bool packed = this->Settings.PackClipStages;
+  std::unordered_map<double, UsdStagePair>& clipStages = packed ? PackedClipStages : cacheEntry->ClipStages;
+
+  auto it = clipStages.find(timeStep);
+  if (it == clipStages.end())
+    return nullptr;
+
+  if (!it->second.second)
+    ReopenTimeVarStage(it->second);
+
+  TouchClipStage(packed ? nullptr : cacheEntry, timeStep);
+
+  return &it->second;
+}
+
+void UsdBridgeUsdWriter::SavePackedClipStages() const
+{
+  if (!this->EnableSaving)
+    return;
+
+  // Only layers with changes since their last save are written
+  for (auto& x : PackedClipStages)
+  {
+    if (x.second.second)
+      SaveTimeVarStage(x.second.second);
+  }
+}
+
+void UsdBridgeUsdWriter::RemoveFromPackedClipStages(const UsdBridgePrimCache* cacheEntry)
+{
+  for (double timeStep : cacheEntry->PackedClipTimeSteps)
+  {
+    auto it = PackedClipStages.find(timeStep);
+    if (it == PackedClipStages.end())
+      continue;
+
+    // Other prims keep using the stage, so only the prim's data is removed from it
+    if (!it->second.second)
+      ReopenTimeVarStage(it->second);
+    TouchClipStage(nullptr, timeStep);
+
+    if (it->second.second->GetPrimAtPath(cacheEntry->PrimPath))
+      it->second.second->RemovePrim(cacheEntry->PrimPath);
+  }
+}
 #endif
 
 
 void UsdBridgeUsdWriter::GetRootPrimPath(const SdfPath& name, const char* primPathCp, SdfPath& rootPrimPath)
 {
-  rootPrimPath = SdfPath(this->RootName);
-  rootPrimPath = rootPrimPath.AppendPath(SdfPath(primPathCp));
-  rootPrimPath = rootPrimPath.AppendPath(name);
+  rootPrimPath = RelPrimPath(this->RootName.c_str())
+    .AppendPath(RelPrimPath(primPathCp))
+    .AppendPath(name);
 }
 
 void UsdBridgeUsdWriter::AddRootPrim(UsdBridgePrimCache* primCache, const char* primPathCp, const char* layerId)
@@ -633,23 +1012,34 @@ const std::string& UsdBridgeUsdWriter::CreatePrimName(const char * name, const c
 const std::string& UsdBridgeUsdWriter::GetResourceFileName(const std::string& basePath, double timeStep, const char* fileExtension)
 {
   this->TempNameStr = basePath;
-#ifdef TIME_BASED_CACHING
-  this->TempNameStr += "_";
-  this->TempNameStr += std::to_string(timeStep);
-#endif
-  this->TempNameStr += fileExtension; 
-
-  return this->TempNameStr;
+  return AppendResourceFileSuffix(timeStep, fileExtension);
 }
 
 const std::string& UsdBridgeUsdWriter::GetResourceFileName(const char* folderName, const std::string& objectName, double timeStep, const char* fileExtension)
 {
-  return GetResourceFileName(folderName + objectName, timeStep, fileExtension);
+  // Compose directly into the temp string, without intermediate string objects
+  (this->TempNameStr = folderName).append(objectName);
+  return AppendResourceFileSuffix(timeStep, fileExtension);
 }
 
 const std::string& UsdBridgeUsdWriter::GetResourceFileName(const char* folderName, const char* optionalObjectName, const std::string& defaultObjectName, double timeStep, const char* fileExtension)
 {
-  return GetResourceFileName(folderName, (optionalObjectName ? std::string(optionalObjectName) : defaultObjectName), timeStep, fileExtension);
+  if(optionalObjectName)
+    (this->TempNameStr = folderName).append(optionalObjectName);
+  else
+    (this->TempNameStr = folderName).append(defaultObjectName);
+  return AppendResourceFileSuffix(timeStep, fileExtension);
+}
+
+const std::string& UsdBridgeUsdWriter::AppendResourceFileSuffix(double timeStep, const char* fileExtension)
+{
+#ifdef TIME_BASED_CACHING
+  this->TempNameStr += "_";
+  this->TempNameStr += std::to_string(timeStep);
+#endif
+  this->TempNameStr += fileExtension; 
+
+  return this->TempNameStr;
 }
 
 bool UsdBridgeUsdWriter::CreatePrim(const SdfPath& path)
@@ -666,11 +1056,18 @@ bool UsdBridgeUsdWriter::CreatePrim(const SdfPath& path)
 
 void UsdBridgeUsdWriter::DeletePrim(const UsdBridgePrimCache* cacheEntry)
 {
+  UsdBridgeSdfEditBatch::FlushActive(); // Deferred edits and saves of the prim's stages are performed before its files are removed
+
   if(SceneStage->GetPrimAtPath(cacheEntry->PrimPath))
     SceneStage->RemovePrim(cacheEntry->PrimPath);
+  ReleaseLibraryShapes(cacheEntry->PrimPath);
 
 #ifdef VALUE_CLIP_RETIMING
   RemoveManifestAndClipStages(cacheEntry);
+  DirtyClipTableCaches.erase(const_cast<UsdBridgePrimCache*>(cacheEntry)); // Its referencing prims are gone with it
+  UnsavedManifestCaches.erase(const_cast<UsdBridgePrimCache*>(cacheEntry));
+  NewManifestCaches.erase(const_cast<UsdBridgePrimCache*>(cacheEntry));
+  ClipTableCaches.erase(const_cast<UsdBridgePrimCache*>(cacheEntry));
 #endif
 }
 
@@ -775,13 +1172,12 @@ void UsdBridgeUsdWriter::ChildrenRemoveIfInvisibleAnytime(UsdStageRefPtr stage,
 
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
+void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
 {
   UsdClipsAPI clipsApi(clipPrim);
 
   clipsApi.SetClipPrimPath(childCache->PrimPath.GetString());
 
-  const std::string& manifestPath = childCache->ManifestStage.first;
   const std::string* refStagePath;
 #ifdef TIME_CLIP_STAGES
   if (clipStages)
@@ -802,25 +1198,29 @@ void UsdBridgeUsdWriter::InitializeClipMetaData(const UsdPrim& clipPrim, UsdBrid
     refStagePath = &childCache->GetPrimStagePair().first;
   }
 
-  clipsApi.SetClipManifestAssetPath(SdfAssetPath(manifestPath));
+  // (Re)start the clip table of the referencing prim
+  if(!parentCache->ClipTables)
+    parentCache->ClipTables = std::make_unique<UsdBridgePrimCache::ClipTableContainer>();
+  ClipTableCaches.insert(parentCache);
+  UsdBridgeClipTable& clipTable = (*parentCache->ClipTables)[clipPrim.GetPath()];
+  clipTable = UsdBridgeClipTable();
 
-  VtArray<SdfAssetPath> assetPaths;
-  assetPaths.push_back(SdfAssetPath(*refStagePath));
-  clipsApi.SetClipAssetPaths(assetPaths);
+  clipTable.ClipPrimPath = childCache->PrimPath;
+  clipTable.ManifestPath = GetClipManifestPath(childCache);
 
-  VtVec2dArray clipActives;
-  clipActives.push_back(GfVec2d(parentTimeStep, 0));
-  clipsApi.SetClipActive(clipActives);
+  clipTable.AssetPaths.push_back(*refStagePath);
+  clipTable.AssetIndices.emplace(*refStagePath, 0);
+  clipTable.AssetUseCounts.push_back(1);
+  clipTable.ClipActives.emplace(parentTimeStep, 0);
+  clipTable.ClipTimes.emplace(parentTimeStep, childTimeStep);
 
-  VtVec2dArray clipTimes;
-  clipTimes.push_back(GfVec2d(parentTimeStep, childTimeStep));
-  clipsApi.SetClipTimes(clipTimes);
+  WriteClipTable(clipsApi, clipTable);
 }
 
-void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
+void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix)
 {
   // Add parent-child timestep or update existing relationship
-  UsdClipsAPI clipsApi(clipPrim);
+  UsdBridgeClipTable& clipTable = GetOrCreateClipTable(clipPrim, parentCache);
 
 #ifdef TIME_CLIP_STAGES
   if (clipStages)
@@ -832,80 +1232,191 @@ void UsdBridgeUsdWriter::UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePr
 
     const std::string& refStagePath = childStagePair.first;
 
-    VtVec2dArray clipActives;
-    clipsApi.GetClipActive(&clipActives);
-    VtArray<SdfAssetPath> assetPaths;
-    clipsApi.GetClipAssetPaths(&assetPaths);
-
     // Find the asset path
-    SdfAssetPath refStageSdf(refStagePath);
-    auto assetIt = std::find_if(assetPaths.begin(), assetPaths.end(), [&refStageSdf](const SdfAssetPath& entry) -> bool { return refStageSdf.GetAssetPath() == entry.GetAssetPath(); });
-    int assetIndex = int(assetIt - assetPaths.begin());
-    bool newAsset = (assetIndex == assetPaths.size()); // Gives the opportunity to garbage collect unused asset references
+    auto assetIt = clipTable.AssetIndices.find(refStagePath);
+    bool newAsset = (assetIt == clipTable.AssetIndices.end()); // Gives the opportunity to garbage collect unused asset references
+    int assetIndex = newAsset ? int(clipTable.AssetPaths.size()) : assetIt->second;
+
+    bool replaceAsset = false;
 
+    // Find the parentTimeStep, if not found just add (time, asset ref idx) to actives
+    auto activeIt = clipTable.ClipActives.find(parentTimeStep);
+    if (activeIt == clipTable.ClipActives.end())
+      clipTable.ClipActives.emplace(parentTimeStep, assetIndex);
+    else
     {
-      // Find the parentTimeStep
-      int timeFindIdx = 0;
-      for (; timeFindIdx < clipActives.size() && clipActives[timeFindIdx][0] != parentTimeStep; ++timeFindIdx)
-      {}
+      // Find out whether to update existing active entry with new asset ref idx, or let the entry unchanged and replace the asset itself
+      int prevAssetIndex = activeIt->second;
 
-      bool replaceAsset = false;
+      // Replacement occurs when prevAssetIndex isn't used by other entries
+      replaceAsset = newAsset && (clipTable.AssetUseCounts[prevAssetIndex] == 1);
 
-      // If timestep not found, just add (time, asset ref idx) to actives
-      if (timeFindIdx == clipActives.size())
-        clipActives.push_back(GfVec2d(parentTimeStep, assetIndex));
+      if(replaceAsset)
+      {
+        clipTable.AssetIndices.erase(clipTable.AssetPaths[prevAssetIndex]);
+        clipTable.AssetPaths[prevAssetIndex] = refStagePath;
+        clipTable.AssetIndices.emplace(refStagePath, prevAssetIndex);
+      }
       else
       {
-        // Find out whether to update existing active entry with new asset ref idx, or let the entry unchanged and replace the asset itself
-        double prevAssetIndex = clipActives[timeFindIdx][1];
-       
-        if (newAsset)
-        {
-          //Find prev asset index
-          int assetIdxFindIdx = 0;
-          for (; assetIdxFindIdx < clipActives.size() && 
-            (assetIdxFindIdx == timeFindIdx || clipActives[assetIdxFindIdx][1] != prevAssetIndex); 
-            ++assetIdxFindIdx)
-          {}
-
-          // replacement occurs when prevAssetIndex hasn't been found in other entries
-          replaceAsset = (assetIdxFindIdx == clipActives.size());
-        }
-
-        if(replaceAsset)
-          assetPaths[int(prevAssetIndex)] = refStageSdf;
-        else
-          clipActives[timeFindIdx][1] = assetIndex;
+        --clipTable.AssetUseCounts[prevAssetIndex];
+        activeIt->second = assetIndex;
       }
+    }
 
-      // If new asset and not put in place of an old asset, add to assetPaths
-      if (newAsset && !replaceAsset)
-        assetPaths.push_back(refStageSdf);
-
-      // Send the result through to usd
-      clipsApi.SetClipAssetPaths(assetPaths);
-      clipsApi.SetClipActive(clipActives);
+    // If new asset and not put in place of an old asset, add to assetPaths
+    if (newAsset && !replaceAsset)
+    {
+      clipTable.AssetPaths.push_back(refStagePath);
+      clipTable.AssetIndices.emplace(refStagePath, assetIndex);
+      clipTable.AssetUseCounts.push_back(0);
     }
+    if (!replaceAsset)
+      ++clipTable.AssetUseCounts[assetIndex];
   }
 #endif
 
-  // Find the parentTimeStep, and change its child (or add the pair if nonexistent)
+  // Change the child of parentTimeStep (or add the pair if nonexistent)
+  clipTable.ClipTimes[parentTimeStep] = childTimeStep;
+
+  clipTable.ClipPrimPath = childCache->PrimPath;
+  clipTable.ManifestPath = GetClipManifestPath(childCache);
+
+  // Metadata is written at the next flush
+  clipTable.Dirty = true;
+  DirtyClipTableCaches.insert(parentCache);
+}
+
+UsdBridgeClipTable& UsdBridgeUsdWriter::GetOrCreateClipTable(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache)
+{
+  if(!parentCache->ClipTables)
+    parentCache->ClipTables = std::make_unique<UsdBridgePrimCache::ClipTableContainer>();
+  ClipTableCaches.insert(parentCache);
+
+  auto empRes = parentCache->ClipTables->emplace(clipPrim.GetPath(), UsdBridgeClipTable());
+  UsdBridgeClipTable& clipTable = empRes.first->second;
+  if(empRes.second)
+  {
+    // No table yet, ie. when the bridge is recreated on an existing stage; read the metadata once
+    UsdClipsAPI clipsApi(clipPrim);
+
+    VtArray<SdfAssetPath> assetPaths;
+    clipsApi.GetClipAssetPaths(&assetPaths);
+    for(const SdfAssetPath& assetPath : assetPaths)
+    {
+      clipTable.AssetIndices.emplace(assetPath.GetAssetPath(), int(clipTable.AssetPaths.size()));
+      clipTable.AssetPaths.push_back(assetPath.GetAssetPath());
+    }
+    clipTable.AssetUseCounts.resize(clipTable.AssetPaths.size(), 0);
+
+    VtVec2dArray clipActives;
+    clipsApi.GetClipActive(&clipActives);
+    for(const GfVec2d& active : clipActives)
+    {
+      int assetIndex = int(active[1]);
+      if(assetIndex >= 0 && assetIndex < int(clipTable.AssetPaths.size()))
+      {
+        clipTable.ClipActives[active[0]] = assetIndex;
+        ++clipTable.AssetUseCounts[assetIndex];
+      }
+    }
+
+    VtVec2dArray clipTimes;
+    clipsApi.GetClipTimes(&clipTimes);
+    for(const GfVec2d& clipTime : clipTimes)
+      clipTable.ClipTimes[clipTime[0]] = clipTime[1];
+
+    std::string clipPrimPath;
+    if(clipsApi.GetClipPrimPath(&clipPrimPath) && !clipPrimPath.empty())
+      clipTable.ClipPrimPath = SdfPath(clipPrimPath);
+
+    SdfAssetPath manifestPath;
+    clipsApi.GetClipManifestAssetPath(&manifestPath);
+    clipTable.ManifestPath = manifestPath.GetAssetPath();
+  }
+
+  return clipTable;
+}
+
+void UsdBridgeUsdWriter::WriteClipTable(UsdClipsAPI& clipsApi, const UsdBridgeClipTable& clipTable) const
+{
+  clipsApi.SetClipManifestAssetPath(SdfAssetPath(clipTable.ManifestPath));
+
+  VtArray<SdfAssetPath> assetPaths;
+  assetPaths.reserve(clipTable.AssetPaths.size());
+  for(const std::string& assetPath : clipTable.AssetPaths)
+    assetPaths.push_back(SdfAssetPath(assetPath));
+  clipsApi.SetClipAssetPaths(assetPaths);
+
+  VtVec2dArray clipActives;
+  clipActives.reserve(clipTable.ClipActives.size());
+  for(const auto& active : clipTable.ClipActives)
+    clipActives.push_back(GfVec2d(active.first, active.second));
+  clipsApi.SetClipActive(clipActives);
+
   VtVec2dArray clipTimes;
-  clipsApi.GetClipTimes(&clipTimes);
+  clipTimes.reserve(clipTable.ClipTimes.size());
+  for(const auto& clipTime : clipTable.ClipTimes)
+    clipTimes.push_back(GfVec2d(clipTime.first, clipTime.second));
+  clipsApi.SetClipTimes(clipTimes);
+}
+
+void UsdBridgeUsdWriter::FlushClipMetaData()
+{
+  if(!SceneStage)
   {
-    int findIdx = 0;
-    for (; findIdx < clipTimes.size(); ++findIdx)
+    DirtyClipTableCaches.clear();
+    NewManifestCaches.clear();
+    return;
+  }
+
+  if(!NewManifestCaches.empty())
+  {
+    // Point the clips of children which received a manifest to it, instead of to the empty manifest
+    for(UsdBridgePrimCache* childCache : NewManifestCaches)
     {
-      if (clipTimes[findIdx][0] == parentTimeStep)
+      const std::string& manifestPath = childCache->ManifestStage.first;
+      for(UsdBridgePrimCache* parentCache : ClipTableCaches)
       {
-        clipTimes[findIdx][1] = childTimeStep;
-        break;
+        for(auto& clipTableEntry : *parentCache->ClipTables)
+        {
+          UsdBridgeClipTable& clipTable = clipTableEntry.second;
+          if(clipTable.ClipPrimPath == childCache->PrimPath && clipTable.ManifestPath != manifestPath)
+          {
+            clipTable.ManifestPath = manifestPath;
+            clipTable.Dirty = true;
+            DirtyClipTableCaches.insert(parentCache);
+          }
+        }
+      }
+    }
+    NewManifestCaches.clear();
+  }
+
+  for(UsdBridgePrimCache* parentCache : DirtyClipTableCaches)
+  {
+    UsdBridgePrimCache::ClipTableContainer& clipTables = *parentCache->ClipTables;
+    for(auto it = clipTables.begin(); it != clipTables.end(); )
+    {
+      UsdPrim clipPrim = SceneStage->GetPrimAtPath(it->first);
+      if(!clipPrim)
+      {
+        // Referencing prim has been removed in the meantime
+        it = clipTables.erase(it);
+        continue;
+      }
+
+      UsdBridgeClipTable& clipTable = it->second;
+      if(clipTable.Dirty)
+      {
+        UsdClipsAPI clipsApi(clipPrim);
+        WriteClipTable(clipsApi, clipTable);
+        clipTable.Dirty = false;
       }
+      ++it;
     }
-    if (findIdx == clipTimes.size())
-      clipTimes.push_back(GfVec2d(parentTimeStep, childTimeStep));
-    clipsApi.SetClipTimes(clipTimes);
   }
+  DirtyClipTableCaches.clear();
 }
 
 #endif
@@ -937,7 +1448,7 @@ SdfPath UsdBridgeUsdWriter::AddRef_Impl(UsdBridgePrimCache* parentCache, UsdBrid
 
   SdfPath childBasePath = parentCache->PrimPath;
   if (refPathExt)
-    childBasePath = parentCache->PrimPath.AppendPath(SdfPath(refPathExt));
+    childBasePath = parentCache->PrimPath.AppendPath(RelPrimPath(refPathExt));
   
   SdfPath referencingPrimPath = childBasePath.AppendPath(childCache->Name);
   UsdPrim referencingPrim = SceneStage->GetPrimAtPath(referencingPrimPath);
@@ -949,7 +1460,7 @@ SdfPath UsdBridgeUsdWriter::AddRef_Impl(UsdBridgePrimCache* parentCache, UsdBrid
 
 #ifdef VALUE_CLIP_RETIMING
     if (valueClip)
-      InitializeClipMetaData(referencingPrim, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+      InitializeClipMetaData(referencingPrim, parentCache, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
 #endif
 
     {
@@ -988,7 +1499,7 @@ SdfPath UsdBridgeUsdWriter::AddRef_Impl(UsdBridgePrimCache* parentCache, UsdBrid
     // Cliptimes are added as additional info, not actively removed (visibility values remain leading in defining existing relationships over timesteps)
     // Also, clip stages at childTimeSteps which are not referenced anymore, are not removed; they could still be referenced from other parents!
     if (valueClip)
-      UpdateClipMetaData(referencingPrim, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
+      UpdateClipMetaData(referencingPrim, parentCache, childCache, parentTimeStep, childTimeStep, clipStages, clipPostfix);
 #endif
 #endif
   }
@@ -1003,7 +1514,7 @@ void UsdBridgeUsdWriter::RemoveAllRefs(UsdBridgePrimCache* parentCache, const ch
 {
   SdfPath childBasePath = parentCache->PrimPath;
   if (refPathExt)
-    childBasePath = parentCache->PrimPath.AppendPath(SdfPath(refPathExt));
+    childBasePath = parentCache->PrimPath.AppendPath(RelPrimPath(refPathExt));
 
   RemoveAllRefs(SceneStage, parentCache, childBasePath, timeVarying, timeStep, atRemoveRef);
 }
@@ -1047,7 +1558,7 @@ void UsdBridgeUsdWriter::ManageUnusedRefs(UsdStageRefPtr stage, UsdBridgePrimCac
   UsdPrim basePrim;
   if (refPathExt)
   {
-    SdfPath childBasePath = parentCache->PrimPath.AppendPath(SdfPath(refPathExt));
+    SdfPath childBasePath = parentCache->PrimPath.AppendPath(RelPrimPath(refPathExt));
     basePrim = stage->GetPrimAtPath(childBasePath);
   }
   else
@@ -1127,6 +1638,132 @@ void UsdBridgeUsdWriter::UnbindMaterialFromGeom(const SdfPath & refGeomPath)
   UsdShadeMaterialBindingAPI(refGeomPrim).UnbindDirectBinding();
 }
 
+namespace
+{
+  // Splits a row-vector affine transform into the (scale * rotation * translation) components of a point instancer.
+  // Shear cannot be represented by an instancer and is discarded.
+  void DecomposeInstanceTransform(const float* transform, GfVec3f& position, GfQuath& orientation, GfVec3f& scale)
+  {
+    GfVec3d axes[3] = {
+      GfVec3d(transform[0], transform[1], transform[2]),
+      GfVec3d(transform[4], transform[5], transform[6]),
+      GfVec3d(transform[8], transform[9], transform[10])
+    };
+    position = GfVec3f(transform[12], transform[13], transform[14]);
+
+    GfVec3d axisScale(axes[0].GetLength(), axes[1].GetLength(), axes[2].GetLength());
+    if(GfDot(GfCross(axes[0], axes[1]), axes[2]) < 0.0)
+      axisScale[0] = -axisScale[0]; // Mirroring is carried by the scale
+
+    for(int i = 0; i < 3; ++i)
+    {
+      if(axisScale[i] != 0.0)
+        axes[i] /= axisScale[i];
+    }
+    scale = GfVec3f(axisScale);
+
+    GfMatrix3d rotMat;
+    rotMat.SetRow(0, axes[0]);
+    rotMat.SetRow(1, axes[1]);
+    rotMat.SetRow(2, axes[2]);
+    if(!rotMat.Orthonormalize(false))
+      rotMat.SetIdentity();
+
+    orientation = GfQuath(rotMat.ExtractRotation().GetQuat());
+  }
+}
+
+void UsdBridgeUsdWriter::UpdateUsdInstanceBatches(UsdBridgePrimCache* parentCache, const UsdBridgePrimCacheList& groupCaches, const UsdBridgeInstanceBatch* batches,
+  const char* refPathExt, bool timeVarying, double timeStep, const RefModFuncs& refModCallbacks)
+{
+  TimeEvaluator<bool> timeEval(timeVarying, timeStep);
+  UsdBridgeSdfEditBatch editBatch; // The instancers are defined through the stage, their attribute values on the layer
+
+  SdfPath batchBasePath = parentCache->PrimPath.AppendPath(RelPrimPath(refPathExt));
+
+  // Retire instancers of groups that are not batched anymore
+  UsdPrim batchBasePrim = this->SceneStage->GetPrimAtPath(batchBasePath);
+  if(batchBasePrim)
+  {
+    SdfPrimPathList retiredPaths;
+    for(UsdPrim oldInstancer : batchBasePrim.GetAllChildren())
+    {
+      bool found = false;
+      for(size_t groupIdx = 0; groupIdx < groupCaches.size() && !found; ++groupIdx)
+        found = (oldInstancer.GetName() == groupCaches[groupIdx]->PrimPath.GetNameToken());
+      if(!found)
+        retiredPaths.push_back(oldInstancer.GetPath());
+    }
+
+    for(const SdfPath& retiredPath : retiredPaths)
+    {
+#ifdef TIME_BASED_CACHING
+      if(timeVarying)
+      {
+        // Other timesteps may still use the instancer, so only empty it out at this one
+        UsdGeomPointInstancer retiredInstancer = UsdGeomPointInstancer::Get(this->SceneStage, retiredPath);
+        SetUsdAttributeValue(retiredInstancer.GetProtoIndicesAttr(), VtIntArray(), timeEval.Eval());
+        SetUsdAttributeValue(retiredInstancer.GetPositionsAttr(), VtVec3fArray(), timeEval.Eval());
+        SetUsdAttributeValue(retiredInstancer.GetOrientationsAttr(), VtQuathArray(), timeEval.Eval());
+        SetUsdAttributeValue(retiredInstancer.GetScalesAttr(), VtVec3fArray(), timeEval.Eval());
+        continue;
+      }
+#endif
+      UsdBridgePrimCache* groupCache = parentCache->GetChildCache(retiredPath.GetNameToken());
+      if(groupCache)
+        refModCallbacks.AtRemoveRef(parentCache, groupCache);
+      this->SceneStage->RemovePrim(retiredPath);
+    }
+  }
+
+  for(size_t batchIdx = 0; batchIdx < groupCaches.size(); ++batchIdx)
+  {
+    UsdBridgePrimCache* groupCache = groupCaches[batchIdx];
+    const UsdBridgeInstanceBatch& batch = batches[batchIdx];
+
+    SdfPath instancerPath = batchBasePath.AppendChild(groupCache->PrimPath.GetNameToken());
+    UsdGeomPointInstancer instancer = UsdGeomPointInstancer::Get(this->SceneStage, instancerPath);
+    if(instancer && !batch.Changed)
+      continue;
+
+    if(!instancer)
+    {
+      instancer = UsdGeomPointInstancer::Define(this->SceneStage, instancerPath);
+      assert(instancer);
+
+      // The group is the only prototype, referenced from a child of the instancer
+      SdfPath protoPath = instancerPath.AppendChild(UsdBridgeTokens->prototype);
+      UsdPrim protoPrim = this->SceneStage->DefinePrim(protoPath);
+      protoPrim.GetReferences().AddInternalReference(groupCache->PrimPath);
+
+      instancer.CreatePrototypesRel().SetTargets(SdfPathVector{protoPath});
+
+      refModCallbacks.AtNewRef(parentCache, groupCache);
+    }
+
+    size_t numInstances = batch.NumTransforms;
+    VtIntArray protoIndices(numInstances, 0);
+    VtVec3fArray positions(numInstances);
+    VtQuathArray orientations(numInstances);
+    VtVec3fArray scales(numInstances);
+
+    GfVec3f* positionsData = positions.data();
+    GfQuath* orientationsData = orientations.data();
+    GfVec3f* scalesData = scales.data();
+    WorkParallelForN(numInstances, [&batch, positionsData, orientationsData, scalesData](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+        DecomposeInstanceTransform(batch.Transforms + i*16, positionsData[i], orientationsData[i], scalesData[i]);
+    });
+
+    TimeEvaluator<bool> batchTimeEval(batch.TimeVarying, timeStep);
+    ClearAndSetUsdAttribute(instancer.CreateProtoIndicesAttr(), protoIndices, batchTimeEval.Eval(), !batchTimeEval.TimeVarying);
+    ClearAndSetUsdAttribute(instancer.CreatePositionsAttr(), positions, batchTimeEval.Eval(), !batchTimeEval.TimeVarying);
+    ClearAndSetUsdAttribute(instancer.CreateOrientationsAttr(), orientations, batchTimeEval.Eval(), !batchTimeEval.TimeVarying);
+    ClearAndSetUsdAttribute(instancer.CreateScalesAttr(), scales, batchTimeEval.Eval(), !batchTimeEval.TimeVarying);
+  }
+}
+
 void UsdBridgeUsdWriter::UpdateUsdTransform(const SdfPath& transPrimPath, const float* transform, bool timeVarying, double timeStep)
 {
   TimeEvaluator<bool> timeEval(timeVarying, timeStep);
@@ -1141,6 +1778,8 @@ void UsdBridgeUsdWriter::UpdateUsdTransform(const SdfPath& transPrimPath, const
   //Note that instance transform nodes have already been created.
   UsdGeomXform tfPrim = UsdGeomXform::Get(this->SceneStage, transPrimPath);
   assert(tfPrim);
+
+  UsdBridgeSdfEditBatch editBatch;
   tfPrim.ClearXformOpOrder();
   UsdGeomXformOp xformOp = tfPrim.AddTransformOp();
   ClearAndSetUsdAttribute(xformOp.GetAttr(), transMat, timeEval.Eval(), !timeEval.TimeVarying);
@@ -1155,6 +1794,8 @@ void UsdBridgeUsdWriter::UpdateUsdCamera(UsdStageRefPtr timeVarStage, const SdfP
   UsdGeomCamera cameraPrim = UsdGeomCamera::Get(timeVarStage, cameraPrimPath);
   assert(cameraPrim);
 
+  UsdBridgeSdfEditBatch editBatch;
+
   // Set the view matrix
   GfVec3d position(cameraData.Position.Data);
   GfVec3d fwdDir(cameraData.Direction.Data);
@@ -1181,7 +1822,7 @@ void UsdBridgeUsdWriter::UpdateUsdCamera(UsdStageRefPtr timeVarStage, const SdfP
 
   const GfVec3f camScaling(0.01f); // Add a default cam scaling for UI purposes
   UsdGeomXformOp scaleOp = cameraPrim.AddScaleOp();
-  scaleOp.GetAttr().Set(camScaling, UsdTimeCode::Default());
+  SetUsdAttributeValue(scaleOp.GetAttr(), camScaling, UsdTimeCode::Default());
   
   // Helper function for the projection matrix (takes fov in degrees)
   GfCamera gfCam;
@@ -1216,17 +1857,53 @@ void UsdBridgeUsdWriter::UpdateBeginEndTime(double timeStep)
   }
 }
 
+namespace
+{
+  constexpr size_t maxPtrCacheSize = 4096; // Bounds the pointer caches in case of many transient name strings
+}
+
 TfToken& UsdBridgeUsdWriter::AttributeNameToken(const char* attribName)
 {
-  int i = 0;
-  for(; i < AttributeTokens.size(); ++i)
+  auto ptrIt = AttributeTokenPtrs.find(attribName);
+  if(ptrIt != AttributeTokenPtrs.end() && *ptrIt->second == attribName) // Pointer may have been reused for a different string
+    return *ptrIt->second;
+
+  auto empRes = AttributeTokens.emplace(attribName, TfToken());
+  if(empRes.second)
+    empRes.first->second = TfToken(attribName);
+  TfToken* attribToken = &empRes.first->second; // Node-based map, so pointer is stable
+
+  if(AttributeTokenPtrs.size() >= maxPtrCacheSize)
+    AttributeTokenPtrs.clear();
+  AttributeTokenPtrs[attribName] = attribToken;
+
+  return *attribToken;
+}
+
+const std::pair<TfToken, TfToken>& UsdBridgeUsdWriter::QuantParamTokens(const TfToken& attribToken)
+{
+  auto empRes = QuantParamTokenPairs.emplace(attribToken, std::pair<TfToken, TfToken>());
+  if(empRes.second)
   {
-    if(AttributeTokens[i] == attribName) // Overloaded == operator on TfToken
-      break;
+    const std::string& attribName = attribToken.GetString();
+    empRes.first->second = std::make_pair(TfToken(attribName + "_quantScale"), TfToken(attribName + "_quantOffset"));
   }
-  if(i == AttributeTokens.size())
-    AttributeTokens.emplace_back(TfToken(attribName));
-  return AttributeTokens[i];
+  return empRes.first->second;
+}
+
+SdfPath UsdBridgeUsdWriter::RelPrimPath(const char* relPath) const
+{
+  auto ptrIt = PrimPathPtrs.find(relPath);
+  if(ptrIt != PrimPathPtrs.end() && ptrIt->second.first == relPath)
+    return ptrIt->second.second;
+
+  if(PrimPathPtrs.size() >= maxPtrCacheSize)
+    PrimPathPtrs.clear();
+
+  CachedPathEntry& entry = PrimPathPtrs[relPath];
+  entry.first = relPath;
+  entry.second = SdfPath(relPath);
+  return entry.second;
 }
 
 void UsdBridgeUsdWriter::AddSharedResourceRef(const UsdBridgeResourceKey& key)
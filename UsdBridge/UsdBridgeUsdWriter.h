@@ -15,6 +15,12 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 #include <memory>
 #include <functional>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+class UsdBridgeSdfEditBatch;
 
 //Includes detailed usd translation interface of Usd Bridge
 class UsdBridgeUsdWriter
@@ -36,7 +42,19 @@ public:
 
   void SetExternalSceneStage(UsdStageRefPtr sceneStage);
   void SetEnableSaving(bool enableSaving);
+  void SetMaxOpenClipStages(size_t maxOpenClipStages);
   void SaveScene();
+  // Prim, clip and manifest stages consist of just their root layer, so it is saved directly without traversing the stage's used layers.
+  // As with UsdStage::Save(), the layer is only written if it has changed since the last save. Within an edit batch, the save is deferred until its edits are flushed.
+  void SaveTimeVarStage(const UsdStageRefPtr& stage) const;
+  bool ExportScene(const char* exportDirectory);
+
+  // Defers the attribute value edits of all updates in between to a single change block, see UsdBridgeSdfEditBatch
+  void BeginEditBatch();
+  void EndEditBatch();
+
+  bool IsInMemory() const; // All layers are anonymous and files are kept by the connection
+  const std::vector<char>* FindInMemoryFile(const char* assetPath) const; // Asset path relative from the scene
 
   int FindSessionNumber();
   bool CreateDirectories();
@@ -57,12 +75,29 @@ public:
 #endif
     ) const;
 #ifdef VALUE_CLIP_RETIMING
-  void CreateManifestStage(const char* name, const char* primPostfix, UsdBridgePrimCache* cacheEntry);
+  void SetManifestStagePath(const char* name, const char* primPostfix, UsdBridgePrimCache* cacheEntry); // The stage itself is created on first use
+  const UsdStagePair& FindOrCreateManifestStage(UsdBridgePrimCache* cacheEntry); // Schedules the manifest to be saved with the scene
+  const std::string& GetClipManifestPath(UsdBridgePrimCache* childCache); // The child's manifest, or a shared empty one if the child has none
+  void CreateManifestStage(UsdStagePair& manifestStage);
+  void SaveManifestStages();
   void RemoveManifestAndClipStages(const UsdBridgePrimCache* cacheEntry);
 
   const UsdStagePair& FindOrCreatePrimStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix) const;
   const UsdStagePair& FindOrCreateClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, double timeStep, bool& exists) const;
   const UsdStagePair& FindOrCreatePrimClipStage(UsdBridgePrimCache* cacheEntry, const char* namePostfix, bool isClip, double timeStep, bool& exists) const;
+  UsdStagePair CreateOrOpenTimeVarStage(std::string relativeFileName, bool& exists) const;
+  void ReopenTimeVarStage(UsdStagePair& stagePair) const;
+#endif
+#ifdef TIME_CLIP_STAGES
+  // With Settings.PackClipStages, a single clip stage per timestep holds the clip data of all geometry prims, each under its own prim path
+  const UsdStagePair& FindOrCreatePackedClipStage(UsdBridgePrimCache* cacheEntry, double timeStep, bool& exists) const;
+  const UsdStagePair* FindClipStage(UsdBridgePrimCache* cacheEntry, double timeStep) const; // Only existing clip stages, reopened if their handle has been dropped
+  void SavePackedClipStages() const;
+  void RemoveFromPackedClipStages(const UsdBridgePrimCache* cacheEntry);
+  void TouchClipStage(UsdBridgePrimCache* cacheEntry, double timeStep) const;
+  void DropClipStageHandles() const;
+  void DropClipStageHandlesBefore(double timeStep); // Regardless of use, for streaming output (saves the stages, but only drops the bridge-side handles)
+  void RemoveClipStagesFromPool(const UsdBridgePrimCache* cacheEntry);
 #endif
   void GetRootPrimPath(const SdfPath& name, const char* primPathCp, SdfPath& rootPrimPath);
   void AddRootPrim(UsdBridgePrimCache* primCache, const char* primPathCp, const char* layerId = nullptr);
@@ -86,8 +121,11 @@ public:
 #endif
 
 #ifdef VALUE_CLIP_RETIMING
-  void InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
-  void UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  void InitializeClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  void UpdateClipMetaData(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, double parentTimeStep, double childTimeStep, bool clipStages, const char* clipPostfix);
+  UsdBridgeClipTable& GetOrCreateClipTable(const UsdPrim& clipPrim, UsdBridgePrimCache* parentCache);
+  void WriteClipTable(UsdClipsAPI& clipsApi, const UsdBridgeClipTable& clipTable) const;
+  void FlushClipMetaData();
 #endif
 
   SdfPath AddRef_NoClip(UsdBridgePrimCache* parentCache, UsdBridgePrimCache* childCache, const char* refPathExt,
@@ -126,12 +164,12 @@ public:
 #endif
 
 #ifdef VALUE_CLIP_RETIMING
-  void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& meshData);
-  void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& instancerData);
-  void UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& curveData);
-  void UpdateUsdVolumeManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData);
-  void UpdateUsdMaterialManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMaterialData& matData);
-  void UpdateUsdSamplerManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData);
+  void UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& meshData);
+  void UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& instancerData);
+  void UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& curveData);
+  void UpdateUsdVolumeManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData);
+  void UpdateUsdMaterialManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeMaterialData& matData);
+  void UpdateUsdSamplerManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData);
 #endif
 
   void BindMaterialToGeom(const SdfPath& refGeomPath, const SdfPath& refMatPath);
@@ -141,9 +179,16 @@ public:
   void UnbindMaterialFromGeom(const SdfPath & refGeomPath);
 
   void UpdateUsdTransform(const SdfPath& transPrimPath, const float* transform, bool timeVarying, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep);
-  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep);
+  void UpdateUsdInstanceBatches(UsdBridgePrimCache* parentCache, const UsdBridgePrimCacheList& groupCaches, const UsdBridgeInstanceBatch* batches,
+    const char* refPathExt, bool timeVarying, double timeStep, const RefModFuncs& refModCallbacks);
+  void SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeMeshData& geomData, double timeStep) const; // Clears the time-varying bits of members which have not changed yet
+  void SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeInstancerData& geomData, double timeStep) const;
+  void SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeCurveData& geomData, double timeStep) const;
+  void BackFillStaticGeometryMembers(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry); // Authors members which have become dynamic at their earlier timesteps
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& geomData, double timeStep);
+  void UpdateUsdMesh(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep); // Single mesh prim of a (split) mesh geometry
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& geomData, double timeStep);
+  void UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& geomData, double timeStep);
   void UpdateUsdMaterial(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, const UsdGeomPrimvarsAPI& boundGeomPrimvars, double timeStep);
   void UpdatePsShader(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, const UsdGeomPrimvarsAPI& boundGeomPrimvars, double timeStep);
   void UpdateMdlShader(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, const UsdGeomPrimvarsAPI& boundGeomPrimvars, double timeStep);
@@ -158,6 +203,7 @@ public:
   void UpdateUsdCamera(UsdStageRefPtr timeVarStage, const SdfPath& cameraPrimPath, 
     const UsdBridgeCameraData& cameraData, double timeStep, bool timeVarHasChanged);
   void UpdateUsdInstancerPrototypes(const SdfPath& instancerPath, const UsdBridgeInstancerRefData& geomRefData, const SdfPrimPathList& refProtoGeomPrimPaths, const char* protoShapePathRp);
+  void ReleaseLibraryShapes(const SdfPath& instancerPath); // Removes the prototype library shapes which are not referenced by any other instancer
   void UpdateAttributeReader(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, MaterialDMI dataMemberId, const char* newName, const UsdGeomPrimvarsAPI& boundGeomPrimvars, double timeStep, MaterialDMI timeVarying);
   void UpdateInAttribute(UsdStageRefPtr timeVarStage, const SdfPath& samplerPrimPath, const char* newName, double timeStep, SamplerDMI timeVarying);
   void UpdateBeginEndTime(double timeStep);
@@ -168,7 +214,11 @@ public:
 
   void ResetSharedResourceModified();
 
+  // Name conversions are cached per writer, so every distinct name is only tokenized and path-parsed once.
+  // Lookups are keyed on the name pointer first (names from the device are interned), validated against the name contents.
   TfToken& AttributeNameToken(const char* attribName);
+  const std::pair<TfToken, TfToken>& QuantParamTokens(const TfToken& attribToken); // <name>_quantScale and <name>_quantOffset of a quantized attribute
+  SdfPath RelPrimPath(const char* relPath) const; // Relative (or root) prim path from a name or path string
 
   friend void ResourceCollectVolume(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWriter);
   friend void ResourceCollectSampler(UsdBridgePrimCache* cache, UsdBridgeUsdWriter& usdWriter);
@@ -200,18 +250,31 @@ protected:
   // Sets modified flag and returns whether the shared resource has been modified since ResetSharedResourceModified()
   bool SetSharedResourceModified(const UsdBridgeResourceKey& key);
 
+  const std::string& AppendResourceFileSuffix(double timeStep, const char* fileExtension);
+
 #ifdef USE_INDEX_MATERIALS
   void WriteTfPrimvars(const float* tfOpacities, const UsdBridgeVolumeData& volumeData, UsdAttribute& outAttrib, UsdTimeCode outTimeCode);
 #endif
 
   // Token cache for attribute names
-  std::vector<TfToken> AttributeTokens;
+  std::unordered_map<std::string, TfToken> AttributeTokens;
+  std::unordered_map<const char*, TfToken*> AttributeTokenPtrs;
+  std::unordered_map<TfToken, std::pair<TfToken, TfToken>, TfToken::HashFunctor> QuantParamTokenPairs;
+
+  // Prototype shape library entries referenced by each instancer, and the number of instancers referencing each entry
+  std::unordered_map<SdfPath, SdfPrimPathList, SdfPath::Hash> InstancerLibraryShapes;
+  std::unordered_map<SdfPath, int, SdfPath::Hash> LibraryShapeRefCounts;
+
+  // Path cache for prim path strings
+  using CachedPathEntry = std::pair<std::string, SdfPath>;
+  mutable std::unordered_map<const char*, CachedPathEntry> PrimPathPtrs;
 
   // Session specific info
   int SessionNumber = -1;
   UsdStageRefPtr SceneStage;
   UsdStageRefPtr ExternalSceneStage;
   bool EnableSaving = true;
+  std::unique_ptr<UsdBridgeSdfEditBatch> EditBatch; // Spans the updates between BeginEditBatch() and EndEditBatch()
   std::string SceneFileName;
   std::string SessionDirectory;
   std::string MpiBaseSessionDirectory; // Session directory without rank suffix (only set when MPI active)
@@ -225,6 +288,30 @@ protected:
   double StartTime = 0.0;
   double EndTime = 0.0;
 
+#ifdef TIME_CLIP_STAGES
+  // Clip stages which are open, most recently used first. Beyond MaxOpenClipStages, the least recently used
+  // stages are saved and their handles dropped, to be reopened from file by FindOrCreateClipStage() when updated again.
+  // Dropping a handle only unloads the layer if nothing else holds it; the scene stage's value clips keep
+  // the clip layers they have opened for value resolution alive for as long as the scene stage exists.
+  using ClipStageKey = std::pair<UsdBridgePrimCache*, double>; // Packed clip stages have no prim cache
+  using ClipStageList = std::list<ClipStageKey>;
+  size_t MaxOpenClipStages = 1024; // 0 means unbounded
+  mutable ClipStageList OpenClipStages;
+  mutable std::map<ClipStageKey, ClipStageList::iterator> OpenClipStageEntries;
+  mutable std::unordered_map<double, UsdStagePair> PackedClipStages; // Keyed by timestep, like UsdBridgePrimCache::ClipStages
+
+  void DropClipStageHandle(ClipStageList::iterator listIt) const;
+#endif
+
+#ifdef VALUE_CLIP_RETIMING
+  std::unordered_set<UsdBridgePrimCache*> DirtyClipTableCaches; // Prim caches with clip tables not yet written to the scene stage
+  std::unordered_set<UsdBridgePrimCache*> UnsavedManifestCaches; // Prim caches with manifests not yet saved to file
+  std::unordered_set<UsdBridgePrimCache*> NewManifestCaches; // Prim caches which received a manifest since the last flush
+  std::unordered_set<UsdBridgePrimCache*> ClipTableCaches; // All prim caches with clip tables
+  UsdStagePair EmptyManifestStage; // Manifest of value clips to children without time-varying data
+  bool EmptyManifestUnsaved = false;
+#endif
+
   std::string TempNameStr;
   std::vector<unsigned char> TempImageData;
 };
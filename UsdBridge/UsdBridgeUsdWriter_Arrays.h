@@ -6,12 +6,14 @@
 
 #include "UsdBridgeData.h"
 #include "UsdBridgeUtils.h"
+#include "UsdBridgeUsdWriter_Common.h"
 
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <functional>
 #include <type_traits>
+#include <limits>
 
 #if defined(USE_USDRT) && defined(USE_USDRT_ELTTYPE)
 #define USDBRIDGE_ARRAYTYPE_ELEMENTTYPE using ElementType = typename ArrayType::element_type;
@@ -352,6 +354,114 @@ namespace UsdBridgeArrays
     }
   }
 
+  constexpr size_t ExtentGrainSize = size_t(1) << 16; // Number of points per parallel task
+
+  // Min/max over a range of points, with optional radii expanding each point to a sphere, and optional conversion to a float destination in the same pass.
+  // Written on scalar min/max, so the compiler can vectorize the loop.
+  template<typename SourceScalarType, typename RadiusType, bool WriteDest, bool HasRadii>
+  GfRange3f ComputeExtentKernel(const SourceScalarType* srcPoints, GfVec3f* destPoints, const RadiusType* radii, float uniformRadius,
+    size_t begin, size_t end)
+  {
+    float minX = std::numeric_limits<float>::max(), minY = minX, minZ = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX, maxZ = maxX;
+    for(size_t i = begin; i < end; ++i)
+    {
+      float x = static_cast<float>(srcPoints[i*3]);
+      float y = static_cast<float>(srcPoints[i*3+1]);
+      float z = static_cast<float>(srcPoints[i*3+2]);
+      if constexpr(WriteDest)
+        destPoints[i] = GfVec3f(x, y, z);
+
+      float r = uniformRadius;
+      if constexpr(HasRadii)
+        r = static_cast<float>(radii[i]);
+
+      minX = std::min(minX, x - r); maxX = std::max(maxX, x + r);
+      minY = std::min(minY, y - r); maxY = std::max(maxY, y + r);
+      minZ = std::min(minZ, z - r); maxZ = std::max(maxZ, z + r);
+    }
+
+    if(begin >= end)
+      return GfRange3f();
+    return GfRange3f(GfVec3f(minX, minY, minZ), GfVec3f(maxX, maxY, maxZ));
+  }
+
+  // Parallel extent computation over a point array with 3 scalar components per point.
+  // If destPoints is set, the points are also converted into it, so the source is only traversed once.
+  template<typename SourceScalarType, typename RadiusType = float>
+  GfRange3f ComputeExtent(const SourceScalarType* srcPoints, size_t numPoints, GfVec3f* destPoints = nullptr,
+    const RadiusType* radii = nullptr, float uniformRadius = 0.0f)
+  {
+    auto extentFunc = [srcPoints, destPoints, radii, uniformRadius](size_t begin, size_t end, const GfRange3f& identity) -> GfRange3f
+    {
+      if(destPoints)
+        return radii ? ComputeExtentKernel<SourceScalarType, RadiusType, true, true>(srcPoints, destPoints, radii, uniformRadius, begin, end)
+          : ComputeExtentKernel<SourceScalarType, RadiusType, true, false>(srcPoints, destPoints, radii, uniformRadius, begin, end);
+      else
+        return radii ? ComputeExtentKernel<SourceScalarType, RadiusType, false, true>(srcPoints, destPoints, radii, uniformRadius, begin, end)
+          : ComputeExtentKernel<SourceScalarType, RadiusType, false, false>(srcPoints, destPoints, radii, uniformRadius, begin, end);
+    };
+
+    if(numPoints <= ExtentGrainSize)
+      return extentFunc(0, numPoints, GfRange3f());
+
+    return WorkParallelReduceN(GfRange3f(), numPoints, extentFunc,
+      [](const GfRange3f& lhs, const GfRange3f& rhs) { return GfRange3f::GetUnion(lhs, rhs); },
+      ExtentGrainSize);
+  }
+
+  // Quantizes numElements vectors of numComponents floating point values, per component, onto the integer range [0,QuantMax].
+  // Values are reconstructed as offsets[c] + (q / QuantMax) * scales[c].
+  template<typename SourceScalarType, typename QuantType, uint32_t QuantMax>
+  void WriteToArrayQuantizedComponents(const void* data, size_t numElements, int numComponents, QuantType* dest, float* scales, float* offsets)
+  {
+    const SourceScalarType* typedData = reinterpret_cast<const SourceScalarType*>(data);
+    for(int c = 0; c < numComponents; ++c)
+    {
+      SourceScalarType minVal = std::numeric_limits<SourceScalarType>::max();
+      SourceScalarType maxVal = std::numeric_limits<SourceScalarType>::lowest();
+      for(size_t i = 0; i < numElements; ++i)
+      {
+        SourceScalarType val = typedData[i*numComponents+c];
+        minVal = std::min(minVal, val);
+        maxVal = std::max(maxVal, val);
+      }
+      if(numElements == 0)
+        minVal = maxVal = 0;
+
+      double range = double(maxVal) - double(minVal);
+      double quantFactor = (range > 0.0) ? double(QuantMax) / range : 0.0;
+      for(size_t i = 0; i < numElements; ++i)
+      {
+        double quantVal = (double(typedData[i*numComponents+c]) - double(minVal)) * quantFactor + 0.5;
+        dest[i*numComponents+c] = static_cast<QuantType>(std::min(quantVal, double(QuantMax)));
+      }
+
+      scales[c] = static_cast<float>(range);
+      offsets[c] = static_cast<float>(minVal);
+    }
+  }
+
+  template<typename QuantType, uint32_t QuantMax>
+  bool WriteToArrayQuantized(const UsdBridgeLogObject& logObj, const void* arrayData, UsdBridgeType arrayType, size_t numElements,
+    QuantType* dest, float* scales, float* offsets)
+  {
+    int numComponents = UsdBridgeTypeNumComponents(arrayType);
+    switch (arrayType)
+    {
+      case UsdBridgeType::FLOAT:
+      case UsdBridgeType::FLOAT2:
+      case UsdBridgeType::FLOAT3:
+      case UsdBridgeType::FLOAT4: { WriteToArrayQuantizedComponents<float, QuantType, QuantMax>(arrayData, numElements, numComponents, dest, scales, offsets); break; }
+      case UsdBridgeType::DOUBLE:
+      case UsdBridgeType::DOUBLE2:
+      case UsdBridgeType::DOUBLE3:
+      case UsdBridgeType::DOUBLE4: { WriteToArrayQuantizedComponents<double, QuantType, QuantMax>(arrayData, numElements, numComponents, dest, scales, offsets); break; }
+      default: { UsdBridgeLogMacro(logObj, UsdBridgeLogLevel::ERR, "Quantized attribute output requires data of type (FLOAT/DOUBLE)(1/2/3/4)."); return false; }
+    }
+    return true;
+  }
+
   #define WRITE_SPAN_MACRO_EXPAND_COL(CompType, NumComponents) \
     WriteToSpanExpandToColor<CompType, NumComponents>(arrayData, destSpan)
 
@@ -556,6 +666,10 @@ namespace UsdBridgeArrays
 
       void AssignToAttrib() override
       {
+#ifndef USE_USDRT
+        if(SetAttribOnLayer(SpanInit.Attrib, *AttribArray, SpanInit.TimeCode))
+          return;
+#endif
         SpanInit.Attrib.Set(*AttribArray, SpanInit.TimeCode);
       }
 
@@ -620,6 +734,38 @@ namespace UsdBridgeArrays
     return result;
   }
 
+  bool IsReducedPrecisionType(UsdBridgeType eltType, UsdBridgeAttributePrecision precision)
+  {
+    return precision != UsdBridgeAttributePrecision::NATIVE
+      && ((eltType >= UsdBridgeType::FLOAT && eltType <= UsdBridgeType::DOUBLE)
+        || (eltType >= UsdBridgeType::FLOAT2 && eltType <= UsdBridgeType::DOUBLE2)
+        || (eltType >= UsdBridgeType::FLOAT3 && eltType <= UsdBridgeType::DOUBLE3)
+        || (eltType >= UsdBridgeType::FLOAT4 && eltType <= UsdBridgeType::DOUBLE4));
+  }
+
+  bool IsQuantizedType(UsdBridgeType eltType, UsdBridgeAttributePrecision precision)
+  {
+    return IsReducedPrecisionType(eltType, precision) && precision != UsdBridgeAttributePrecision::HALF;
+  }
+
+  // Quantized output is flattened to a scalar array, with the number of components as primvar elementSize
+  SdfValueTypeName GetAttribArrayType(UsdBridgeType eltType, UsdBridgeAttributePrecision precision)
+  {
+    if(!IsReducedPrecisionType(eltType, precision))
+      return GetAttribArrayType(eltType);
+
+    if(precision == UsdBridgeAttributePrecision::NORMALIZED8)
+      return SdfValueTypeNames->UCharArray;
+
+    switch (UsdBridgeTypeNumComponents(eltType))
+    {
+      case 2: return SdfValueTypeNames->Half2Array;
+      case 3: return SdfValueTypeNames->Half3Array;
+      case 4: return SdfValueTypeNames->Half4Array;
+      default: return SdfValueTypeNames->HalfArray;
+    }
+  }
+
   // Creates the span using AttributeCType (the type to write to), since at this point both the span and proper type are known.
   template<typename SpanInitType, template <typename T> class SpanI, typename AttributeCType, UsdBridgeType ArrayEltBridgeType>
   UsdBridgeSpanI<AttributeCType>* WriteSpanToAttrib(const UsdBridgeLogObject& logObj, SpanInitType& destSpanInit, const void* arrayData, size_t arrayNumElements)
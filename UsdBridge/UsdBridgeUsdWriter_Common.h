@@ -7,15 +7,19 @@
 #include "UsdBridgeData.h"
 #include "UsdBridgeUtils.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 template<typename T>
 using TimeEvaluator = UsdBridgeTimeEvaluator<T>;
 
 #define MISC_TOKEN_SEQ \
   PROCESS_PREFIX(Root) \
-  PROCESS_PREFIX(extent)
+  PROCESS_PREFIX(extent) \
+  PROCESS_PREFIX(prototype)
 
 #define ATTRIB_TOKEN_SEQ \
   PROCESS_PREFIX(faceVertexCounts) \
@@ -51,7 +55,8 @@ using TimeEvaluator = UsdBridgeTimeEvaluator<T>;
   PROCESS_PREFIX(velocities) \
   PROCESS_PREFIX(angularVelocities) \
   PROCESS_PREFIX(invisibleIds) \
-  PROCESS_PREFIX(curveVertexCounts)
+  PROCESS_PREFIX(curveVertexCounts) \
+  PROCESS_PREFIX(holeIndices)
 
 #define USDPREVSURF_TOKEN_SEQ \
   PROCESS_PREFIX(UsdPreviewSurface) \
@@ -197,6 +202,8 @@ namespace constring
   extern const char* const sessionPf;
   extern const char* const rootClassName;
   extern const char* const rootPrimName;
+  extern const char* const packedClipName;
+  extern const char* const emptyManifestName;
 
   // Folder names
   extern const char* const manifestFolder;
@@ -221,6 +228,13 @@ namespace constring
   extern const char* const mdlSamplerPrimPf;
   extern const char* const openVDBPrimPf;
   extern const char* const protoShapePf;
+  extern const char* const protoShapeLibraryName;
+  extern const char* const staticElementsPrimPf;
+  extern const char* const dynamicElementsPrimPf;
+
+  // Level of detail variants, the simplified levels are named <lodVariantSetName><level>
+  extern const char* const lodVariantSetName;
+  extern const char* const lodFullVariantName;
 
   // Extensions
   extern const char* const imageExtension;
@@ -229,6 +243,7 @@ namespace constring
   // Files
   extern const char* const fullSceneNameBin;
   extern const char* const fullSceneNameAscii;
+  extern const char* const memoryOutputDir;
 
   extern const char* const mdlShaderAssetName;
   extern const char* const mdlSupportAssetName;
@@ -248,6 +263,116 @@ namespace constring
 #endif
 }
 
+// Defers the layer edits of SetAttribOnLayer() while in scope, to perform them within a single SdfChangeBlock once the
+// outermost batch goes out of scope. The block contains nothing but Sdf-level edits, as the stages may not be queried
+// while their change processing is deferred. Values written during a batch are not visible on the stage until it is flushed,
+// so code that reads values back or edits them through the stage first flushes the edits of the layer with FlushLayer().
+// Layer saves requested during a batch are performed after its edits, see AddSave().
+class UsdBridgeSdfEditBatch
+{
+  public:
+    UsdBridgeSdfEditBatch()
+    {
+      if(!ActiveBatch)
+        ActiveBatch = this;
+    }
+
+    ~UsdBridgeSdfEditBatch()
+    {
+      if(ActiveBatch == this)
+      {
+        Flush();
+        ActiveBatch = nullptr;
+      }
+    }
+
+    UsdBridgeSdfEditBatch(const UsdBridgeSdfEditBatch&) = delete;
+    UsdBridgeSdfEditBatch& operator=(const UsdBridgeSdfEditBatch&) = delete;
+
+    // Returns false if there is no active batch to defer the edit to
+    static bool AddEdit(const SdfLayerHandle& layer, const SdfPath& attribPath, const UsdTimeCode& timeCode, VtValue&& value)
+    {
+      if(!ActiveBatch)
+        return false;
+      ActiveBatch->Edits.push_back({layer, attribPath, timeCode, std::move(value)});
+      return true;
+    }
+
+    // Returns false if there is no active batch to defer the save of the stage's root layer to.
+    // The batch keeps the stage open until it is saved.
+    static bool AddSave(const UsdStageRefPtr& stage)
+    {
+      if(!ActiveBatch)
+        return false;
+      ActiveBatch->Saves.push_back(stage);
+      return true;
+    }
+
+    // Performs the deferred edits of a single layer right away
+    static void FlushLayer(const SdfLayerHandle& layer)
+    {
+      if(!ActiveBatch || ActiveBatch->Edits.empty())
+        return;
+
+      std::vector<SdfValueEdit>& edits = ActiveBatch->Edits;
+      auto layerEditsBegin = std::stable_partition(edits.begin(), edits.end(),
+        [&layer](const SdfValueEdit& edit) { return edit.Layer != layer; });
+      ApplyEdits(layerEditsBegin, edits.end());
+      edits.erase(layerEditsBegin, edits.end());
+    }
+
+    // Performs all deferred edits and saves right away, eg. before saving the scene or removing files
+    static void FlushActive()
+    {
+      if(ActiveBatch)
+        ActiveBatch->Flush();
+    }
+
+    void Flush()
+    {
+      ApplyEdits(Edits.begin(), Edits.end());
+      Edits.clear();
+
+      for(UsdStageRefPtr& stage : Saves)
+        stage->GetRootLayer()->Save(); // Layers are only written if they have changed since their last save
+      Saves.clear();
+    }
+
+  protected:
+    struct SdfValueEdit
+    {
+      SdfLayerHandle Layer;
+      SdfPath AttribPath;
+      UsdTimeCode TimeCode;
+      VtValue Value;
+    };
+
+    template<typename EditIterator>
+    static void ApplyEdits(EditIterator editsBegin, EditIterator editsEnd)
+    {
+      if(editsBegin == editsEnd)
+        return;
+
+      SdfChangeBlock changeBlock;
+      for(EditIterator it = editsBegin; it != editsEnd; ++it)
+      {
+        SdfValueEdit& edit = *it;
+        if(!edit.Layer || !edit.Layer->HasSpec(edit.AttribPath)) // Layer closed or prim removed in the meantime
+          continue;
+
+        if(edit.TimeCode.IsDefault())
+          edit.Layer->SetField(edit.AttribPath, SdfFieldKeys->Default, edit.Value);
+        else
+          edit.Layer->SetTimeSample(edit.AttribPath, edit.TimeCode.GetValue(), edit.Value);
+      }
+    }
+
+    std::vector<SdfValueEdit> Edits;
+    std::vector<UsdStageRefPtr> Saves;
+
+    static inline thread_local UsdBridgeSdfEditBatch* ActiveBatch = nullptr;
+};
+
 namespace
 {
   size_t FindLength(std::stringstream& strStream)
@@ -589,12 +714,52 @@ namespace
     return prim;
   }
 
+#ifndef USE_USDRT
+  // Authors the value directly on the layer, bypassing the stage's spec lookup, value type check and time mapping.
+  // Only applies if the stage edits its root layer without remapping and the attribute spec already exists there,
+  // which holds for the attributes of the writer's own prims (in the scene as well as in clip stages).
+  // Within an UsdBridgeSdfEditBatch, the edit is deferred until the batch is flushed.
+  template<typename ValueType>
+  bool SetAttribOnLayer(const UsdAttribute& attrib, const ValueType& value, const UsdTimeCode& timeCode)
+  {
+    UsdStagePtr stage = attrib.GetStage();
+    const UsdEditTarget& editTarget = stage->GetEditTarget();
+    const SdfLayerHandle& layer = editTarget.GetLayer();
+    if(layer != stage->GetRootLayer() || !editTarget.GetMapFunction().IsIdentity())
+      return false;
+
+    const SdfPath& attribPath = attrib.GetPath();
+    SdfAttributeSpecHandle attribSpec = layer->GetAttributeAtPath(attribPath);
+    if(!attribSpec || (!std::is_same_v<ValueType, SdfValueBlock> && attribSpec->GetTypeName().GetType() != TfType::Find<ValueType>()))
+      return false;
+
+    if(UsdBridgeSdfEditBatch::AddEdit(layer, attribPath, timeCode, VtValue(value)))
+      return true;
+
+    if(timeCode.IsDefault())
+      layer->SetField(attribPath, SdfFieldKeys->Default, VtValue(value));
+    else
+      layer->SetTimeSample(attribPath, timeCode.GetValue(), value);
+    return true;
+  }
+#endif
+
+  template<typename ValueType>
+  void SetUsdAttributeValue(const UsdAttribute& attribute, const ValueType& value, const UsdTimeCode& timeCode = UsdTimeCode::Default())
+  {
+#ifndef USE_USDRT
+    if(SetAttribOnLayer(attribute, value, timeCode))
+      return;
+#endif
+    attribute.Set(value, timeCode);
+  }
+
   template<typename ValueType>
   void ClearAndSetUsdAttribute(const UsdAttribute& attribute, const ValueType& value, const UsdTimeCode& timeCode, bool clearAttrib)
   {
     if(clearAttrib)
       attribute.Clear();
-    attribute.Set(value, timeCode);
+    SetUsdAttributeValue(attribute, value, timeCode);
   }
 
   void ClearUsdAttributes(const UsdAttribute& uniformAttrib, const UsdAttribute& timeVarAttrib, bool timeVaryingUpdate)
@@ -616,9 +781,13 @@ namespace
 #endif
 #else // !VALUE_CLIP_RETIMING
     // Uniform and timeVar geoms are the same. In case of uniform values, make sure the timesamples are cleared out.
-    if(!timeVaryingUpdate && timeVarAttrib)
+    // The default value is kept, as it is either overwritten by the update, or it is the uniform value of a member without an update (eg. of a split mesh).
+    if(!timeVaryingUpdate && timeVarAttrib && timeVarAttrib.GetNumTimeSamples())
     {
-      timeVarAttrib.Clear();
+      std::vector<double> timeSamples;
+      timeVarAttrib.GetTimeSamples(&timeSamples);
+      for(double timeSample : timeSamples)
+        timeVarAttrib.ClearAtTime(timeSample);
     }
 #endif
 #endif
@@ -639,8 +808,8 @@ namespace
 
 #define SET_TIMEVARYING_ATTRIB(_timeVaryingUpdate, _timeVarAttrib, _uniformAttrib, _value) \
   if(_timeVaryingUpdate) \
-    _timeVarAttrib.Set(_value, timeEval.TimeCode); \
+    SetUsdAttributeValue(_timeVarAttrib, _value, timeEval.TimeCode); \
   else \
-    _uniformAttrib.Set(_value, timeEval.Default());
+    SetUsdAttributeValue(_uniformAttrib, _value, timeEval.Default());
 
 #endif
\ No newline at end of file
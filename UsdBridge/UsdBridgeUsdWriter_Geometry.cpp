@@ -13,6 +13,7 @@ namespace
   struct UsdGeomUpdateArguments
   {
     UsdBridgeRt& UsdRtData;
+    UsdBridgePrimCache* CacheEntry;
     const GeomDataType& GeomData;
     const UsdBridgeSettings& Settings;
     uint64_t NumPrims;
@@ -21,6 +22,7 @@ namespace
   };
   #define UNPACK_UPDATE_ARGS\
     UsdBridgeRt& usdRtData = updateArgs.UsdRtData;\
+    UsdBridgePrimCache* cacheEntry = updateArgs.CacheEntry;\
     const GeomDataType& geomData = updateArgs.GeomData;\
     const UsdBridgeSettings& settings = updateArgs.Settings;\
     uint64_t numPrims = updateArgs.NumPrims;\
@@ -149,6 +151,74 @@ namespace
       primvarApi.RemovePrimvar(UsdBridgeTokens->st);
   }
 
+  SdfValueTypeName GetQuantParamType(int numComponents)
+  {
+    switch (numComponents)
+    {
+      case 2: return SdfValueTypeNames->Float2;
+      case 3: return SdfValueTypeNames->Float3;
+      case 4: return SdfValueTypeNames->Float4;
+      default: return SdfValueTypeNames->Float;
+    }
+  }
+
+  SdfValueTypeName GetAttribOutputArrayType(const UsdBridgeAttribute& attrib)
+  {
+    return UsdBridgeArrays::GetAttribArrayType(attrib.DataType, attrib.OutputPrecision);
+  }
+
+  int GetAttribOutputElementSize(const UsdBridgeAttribute& attrib)
+  {
+    return UsdBridgeArrays::IsQuantizedType(attrib.DataType, attrib.OutputPrecision) ? UsdBridgeTypeNumComponents(attrib.DataType) : 1;
+  }
+
+  void CreateUsdGeomQuantParamPrimvars(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& primvarApi, const TfToken& attribToken, const UsdBridgeAttribute& attrib, bool create)
+  {
+    const std::pair<TfToken, TfToken>& paramTokens = writer->QuantParamTokens(attribToken);
+    const TfToken& scaleToken = paramTokens.first;
+    const TfToken& offsetToken = paramTokens.second;
+
+    if(create)
+    {
+      SdfValueTypeName paramType = GetQuantParamType(UsdBridgeTypeNumComponents(attrib.DataType));
+
+      for(const TfToken& paramToken : {scaleToken, offsetToken})
+      {
+        UsdGeomPrimvar primvar = primvarApi.GetPrimvar(paramToken);
+        if(primvar && primvar.GetTypeName() != paramType)
+          primvarApi.RemovePrimvar(paramToken);
+        primvarApi.CreatePrimvar(paramToken, paramType, UsdGeomTokens->constant);
+      }
+    }
+    else
+    {
+      if(primvarApi.HasPrimvar(scaleToken))
+        primvarApi.RemovePrimvar(scaleToken);
+      if(primvarApi.HasPrimvar(offsetToken))
+        primvarApi.RemovePrimvar(offsetToken);
+    }
+  }
+
+  void SetUsdGeomQuantParams(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& primvarApi, const TfToken& attribToken, int numComponents,
+    const float* scales, const float* offsets, const UsdTimeCode& timeCode)
+  {
+    auto toValue = [numComponents](const float* v) -> VtValue
+    {
+      switch (numComponents)
+      {
+        case 2: return VtValue(GfVec2f(v[0], v[1]));
+        case 3: return VtValue(GfVec3f(v[0], v[1], v[2]));
+        case 4: return VtValue(GfVec4f(v[0], v[1], v[2], v[3]));
+        default: return VtValue(v[0]);
+      }
+    };
+
+    SdfValueTypeName paramType = GetQuantParamType(numComponents);
+    const std::pair<TfToken, TfToken>& paramTokens = writer->QuantParamTokens(attribToken);
+    primvarApi.CreatePrimvar(paramTokens.first, paramType, UsdGeomTokens->constant).Set(toValue(scales), timeCode);
+    primvarApi.CreatePrimvar(paramTokens.second, paramType, UsdGeomTokens->constant).Set(toValue(offsets), timeCode);
+  }
+
   template<typename GeomDataType>
   void CreateUsdGeomAttributePrimvar(UsdBridgeUsdWriter* writer, UsdGeomPrimvarsAPI& primvarApi, const GeomDataType& geomData, uint32_t attribIndex, const TimeEvaluator<GeomDataType>* timeEval = nullptr)
   {
@@ -168,7 +238,7 @@ namespace
 
       if(timeVarChecked)
       {
-        SdfValueTypeName primvarType = UsdBridgeArrays::GetAttribArrayType(attrib.DataType);
+        SdfValueTypeName primvarType = GetAttribOutputArrayType(attrib);
         if(primvarType == SdfValueTypeNames->BoolArray)
         {
           UsdBridgeLogMacro(writer->LogObject, UsdBridgeLogLevel::WARNING, "UsdGeom Attribute<" << attribIndex << "> primvar does not support source data type: " << attrib.DataType);
@@ -180,11 +250,19 @@ namespace
         {
           primvarApi.RemovePrimvar(attribToken);
         }
-        primvarApi.CreatePrimvar(attribToken, primvarType);
+        UsdGeomPrimvar newPrimvar = primvarApi.CreatePrimvar(attribToken, primvarType);
+
+        // Quantized output is flattened, with the vector components stored as elements
+        int elementSize = GetAttribOutputElementSize(attrib);
+        if(newPrimvar.GetElementSize() != elementSize)
+          newPrimvar.SetElementSize(elementSize);
+
+        CreateUsdGeomQuantParamPrimvars(writer, primvarApi, attribToken, attrib, UsdBridgeArrays::IsQuantizedType(attrib.DataType, attrib.OutputPrecision));
       }
       else if(timeEval)
       {
         primvarApi.RemovePrimvar(attribToken);
+        CreateUsdGeomQuantParamPrimvars(writer, primvarApi, attribToken, attrib, false);
       }
     }
   }
@@ -212,6 +290,7 @@ namespace
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::INDICES, CreateFaceVertexIndicesAttr, UsdBridgeTokens->faceVertexCounts);
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::INDICES, CreateFaceVertexCountsAttr, UsdBridgeTokens->faceVertexIndices);
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::NORMALS, CreateNormalsAttr, UsdBridgeTokens->normals);
+    CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::LINEARVELOCITIES, CreateVelocitiesAttr, UsdBridgeTokens->velocities);
 
     if(!settings.UseDisplayColorOpacity)
       CreateUsdGeomColorPrimvars(primvarApi, meshData, settings, timeEval);
@@ -241,6 +320,7 @@ namespace
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::INSTANCEIDS, CreateIdsAttr, UsdBridgeTokens->ids);
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::ORIENTATIONS, CreateNormalsAttr, UsdBridgeTokens->normals);
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::SCALES, CreateWidthsAttr, UsdBridgeTokens->widths);
+    CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::LINEARVELOCITIES, CreateVelocitiesAttr, UsdBridgeTokens->velocities);
 
     if(!settings.UseDisplayColorOpacity)
       CreateUsdGeomColorPrimvars(primvarApi, instancerData, settings, timeEval);
@@ -282,8 +362,8 @@ namespace
 
     CreateUsdGeomAttributePrimvars(writer, primvarApi, instancerData, timeEval);
 
-    //CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::LINEARVELOCITIES, CreateVelocitiesAttr, UsdBridgeTokens->velocities);
-    //CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::ANGULARVELOCITIES, CreateAngularVelocitiesAttr, UsdBridgeTokens->angularVelocities);
+    CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::LINEARVELOCITIES, CreateVelocitiesAttr, UsdBridgeTokens->velocities);
+    CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::ANGULARVELOCITIES, CreateAngularVelocitiesAttr, UsdBridgeTokens->angularVelocities);
     CREATE_REMOVE_TIMEVARYING_ATTRIB_QUALIFIED(DMI::INVISIBLEIDS, CreateInvisibleIdsAttr, UsdBridgeTokens->invisibleIds);
   }
 
@@ -317,11 +397,21 @@ namespace
 
   }
 
-  UsdPrim InitializeUsdGeometry_Impl(UsdBridgeUsdWriter* writer, UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeMeshData& meshData, bool uniformPrim,
+  // Meshes are split into a static and a dynamic prim with usd::timeSampleSharing, see UsdBridgeMeshElementCache
+  bool SplitsMeshElements(const UsdBridgeSettings& settings)
+  {
+#ifdef TIME_BASED_CACHING
+    return settings.ShareTimeSamples;
+#else
+    return false;
+#endif
+  }
+
+  UsdGeomMesh InitializeUsdMesh(UsdBridgeUsdWriter* writer, UsdStageRefPtr geometryStage, const SdfPath& meshPath, const UsdBridgeMeshData& meshData, bool uniformPrim,
     const UsdBridgeSettings& settings,
-    TimeEvaluator<UsdBridgeMeshData>* timeEval = nullptr)
+    const TimeEvaluator<UsdBridgeMeshData>* timeEval = nullptr)
   {
-    UsdGeomMesh geomMesh = GetOrDefinePrim<UsdGeomMesh>(geometryStage, geomPath);
+    UsdGeomMesh geomMesh = GetOrDefinePrim<UsdGeomMesh>(geometryStage, meshPath);
 
     InitializeUsdGeometryTimeVar(writer, geomMesh, meshData, settings, timeEval);
 
@@ -331,7 +421,42 @@ namespace
       geomMesh.CreateSubdivisionSchemeAttr().Set(UsdGeomTokens->none);
     }
 
-    return geomMesh.GetPrim();
+    return geomMesh;
+  }
+
+  UsdPrim InitializeUsdGeometry_Impl(UsdBridgeUsdWriter* writer, UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeMeshData& meshData, bool uniformPrim,
+    const UsdBridgeSettings& settings,
+    TimeEvaluator<UsdBridgeMeshData>* timeEval = nullptr)
+  {
+    if(!SplitsMeshElements(settings))
+      return InitializeUsdMesh(writer, geometryStage, geomPath, meshData, uniformPrim, settings, timeEval).GetPrim();
+
+    typedef UsdBridgeMeshData::DataMemberId DMI;
+
+    // The mesh prims are children of a non-gprim, as gprims are not allowed to have gprim children
+    UsdGeomXform geomXform = GetOrDefinePrim<UsdGeomXform>(geometryStage, geomPath);
+
+    // Of the static prim, only the hole indices are time-varying. The dynamic prim holds a different selection of elements per timestep,
+    // so all of its members are time-varying. Without time-varying members, the static prim holds the whole mesh.
+    bool splitsElements = !timeEval || (timeEval->Data.TimeVarying & DMI::ALL) != DMI::NONE;
+
+    UsdBridgeMeshData staticData = meshData;
+    staticData.TimeVarying = DMI::NONE;
+    TimeEvaluator<UsdBridgeMeshData> staticTimeEval(staticData);
+    UsdGeomMesh staticMesh = InitializeUsdMesh(writer, geometryStage, geomPath.AppendPath(SdfPath(constring::staticElementsPrimPf)), staticData, uniformPrim,
+      settings, timeEval ? &staticTimeEval : nullptr);
+    if(splitsElements)
+      staticMesh.CreateHoleIndicesAttr();
+    else
+      staticMesh.GetPrim().RemoveProperty(UsdBridgeTokens->holeIndices);
+
+    UsdBridgeMeshData dynamicData = meshData;
+    dynamicData.TimeVarying = splitsElements ? DMI::ALL : DMI::NONE;
+    TimeEvaluator<UsdBridgeMeshData> dynamicTimeEval(dynamicData);
+    InitializeUsdMesh(writer, geometryStage, geomPath.AppendPath(SdfPath(constring::dynamicElementsPrimPf)), dynamicData, uniformPrim,
+      settings, timeEval ? &dynamicTimeEval : nullptr);
+
+    return geomXform.GetPrim();
   }
 
   UsdPrim InitializeUsdGeometry_Impl(UsdBridgeUsdWriter* writer, UsdStageRefPtr geometryStage, const SdfPath& geomPath, const UsdBridgeInstancerData& instancerData, bool uniformPrim,
@@ -378,6 +503,670 @@ namespace
     return geomCurves.GetPrim();
   }
 
+  // Geometry which is sized by widths includes them in its extent (widths are twice the scales, see UpdateUsdGeomWidths)
+  template<typename UsdGeomType>
+  constexpr bool ExtentIncludesRadii()
+  {
+    return std::is_same<UsdGeomType, UsdGeomPoints>::value || std::is_same<UsdGeomType, UsdGeomBasisCurves>::value;
+  }
+
+  template<typename UsdGeomType, typename GeomDataType>
+  void GetExtentRadii(const UsdBridgeLogObject& logObj, const GeomDataType& geomData, const void*& radii, UsdBridgeType& radiiType, float& uniformRadius)
+  {
+    if constexpr(ExtentIncludesRadii<UsdGeomType>())
+    {
+      if(!geomData.Scales)
+        uniformRadius = geomData.getUniformScale();
+      else if(geomData.ScalesType == UsdBridgeType::FLOAT || geomData.ScalesType == UsdBridgeType::DOUBLE)
+      {
+        radii = geomData.Scales;
+        radiiType = geomData.ScalesType;
+      }
+      else
+      {
+        UsdBridgeLogMacro(logObj, UsdBridgeLogLevel::WARNING, "UsdGeom extent only includes radii of FLOAT or DOUBLE type, the extent will not cover the widths.");
+      }
+    }
+  }
+
+  template<typename UsdGeomType, typename GeomDataType>
+  bool PerformsRadiiUpdate(const UsdBridgeUpdateEvaluator<const GeomDataType>& updateEval)
+  {
+    if constexpr(ExtentIncludesRadii<UsdGeomType>())
+      return updateEval.PerformsUpdate(GeomDataType::DataMemberId::SCALES);
+    else
+      return false;
+  }
+
+  // Dispatches the parallel extent computation on the point and radius types; points have to be FLOAT3 or DOUBLE3.
+  GfRange3f ComputePointsExtent(const void* points, UsdBridgeType pointsType, size_t numPoints, GfVec3f* destPoints,
+    const void* radii, UsdBridgeType radiiType, float uniformRadius)
+  {
+    const float* floatRadii = (radiiType == UsdBridgeType::FLOAT) ? static_cast<const float*>(radii) : nullptr;
+    const double* doubleRadii = (radiiType == UsdBridgeType::DOUBLE) ? static_cast<const double*>(radii) : nullptr;
+
+    if(pointsType == UsdBridgeType::DOUBLE3)
+    {
+      const double* srcPoints = static_cast<const double*>(points);
+      return doubleRadii ? UsdBridgeArrays::ComputeExtent(srcPoints, numPoints, destPoints, doubleRadii, uniformRadius)
+        : UsdBridgeArrays::ComputeExtent(srcPoints, numPoints, destPoints, floatRadii, uniformRadius);
+    }
+
+    assert(pointsType == UsdBridgeType::FLOAT3);
+    const float* srcPoints = static_cast<const float*>(points);
+    return doubleRadii ? UsdBridgeArrays::ComputeExtent(srcPoints, numPoints, destPoints, doubleRadii, uniformRadius)
+      : UsdBridgeArrays::ComputeExtent(srcPoints, numPoints, destPoints, floatRadii, uniformRadius);
+  }
+
+#ifdef TIME_CLIP_STAGES
+  constexpr bool shareTimeSamples = false; // Every timestep is written to its own clip layer, which requires its own sample
+#else
+  constexpr bool shareTimeSamples = true;
+#endif
+
+  bool ArraySampleSharingEnabled(const UsdBridgeSettings& settings, UsdBridgeRt& usdRtData, bool timeVaryingUpdate)
+  {
+    return shareTimeSamples && settings.ShareTimeSamples && timeVaryingUpdate && !usdRtData.ValidPrim();
+  }
+
+  using ArraySample = UsdBridgeArraySampleCache::ArraySample;
+
+  // The source arrays and values a sample is written from. Samples are only shared if their bytes are equal; the hash avoids most of the comparisons.
+  // Sources which are compared by hash only (see CompareHashOnly()) don't keep a copy of their bytes in their samples.
+  class ArraySampleSource
+  {
+  public:
+    static ArraySampleSource Block()
+    {
+      ArraySampleSource source;
+      source.Blocked = true;
+      return source;
+    }
+
+    template<typename ValueType>
+    ArraySampleSource& AddValue(const ValueType& value)
+    {
+      const char* bytes = reinterpret_cast<const char*>(&value);
+      Values.insert(Values.end(), bytes, bytes + sizeof(ValueType));
+      Hash = ubutils::HashBytes(bytes, sizeof(ValueType), Hash);
+      Size += sizeof(ValueType);
+      return *this;
+    }
+
+    ArraySampleSource& AddArray(const void* arrayData, UsdBridgeType arrayDataType, size_t arrayNumElements)
+    {
+      AddValue(arrayNumElements);
+      AddValue(arrayDataType);
+      size_t numBytes = arrayNumElements*ubutils::UsdBridgeTypeSize(arrayDataType);
+      Arrays.emplace_back(static_cast<const char*>(arrayData), numBytes);
+      Hash = ubutils::HashBytes(arrayData, numBytes, Hash);
+      Size += numBytes;
+      return *this;
+    }
+
+    // For large arrays of which the hash and size are considered sufficient to detect a change, such as topology
+    ArraySampleSource& CompareHashOnly()
+    {
+      HashOnly = true;
+      return *this;
+    }
+
+    bool Matches(const ArraySample& sample) const
+    {
+      if(Blocked || sample.Blocked)
+        return Blocked == sample.Blocked;
+      if(sample.Hash != Hash || sample.Size != Size)
+        return false;
+      return HashOnly || (sample.Contents && EqualsContents(*sample.Contents));
+    }
+
+    // Shares the contents of an equal sample, if given
+    ArraySample ToSample(bool authored, const ArraySample* equalSample = nullptr) const
+    {
+      ArraySample sample;
+      sample.Hash = Hash;
+      sample.Size = Size;
+      sample.Blocked = Blocked;
+      sample.Authored = authored;
+      if(equalSample)
+        sample.Contents = equalSample->Contents;
+      else if(!Blocked && !HashOnly)
+      {
+        auto contents = std::make_shared<std::vector<char>>(Values);
+        for(const auto& array : Arrays)
+          contents->insert(contents->end(), array.first, array.first + array.second);
+        sample.Contents = std::move(contents);
+      }
+      return sample;
+    }
+
+  protected:
+    // Contents are stored as the values followed by the arrays
+    bool EqualsContents(const std::vector<char>& contents) const
+    {
+      if(contents.size() != Size)
+        return false;
+
+      const char* contentsPtr = contents.data();
+      if(!Values.empty() && memcmp(contentsPtr, Values.data(), Values.size()) != 0)
+        return false;
+      contentsPtr += Values.size();
+      for(const auto& array : Arrays)
+      {
+        if(array.second && memcmp(contentsPtr, array.first, array.second) != 0)
+          return false;
+        contentsPtr += array.second;
+      }
+      return true;
+    }
+
+    uint64_t Hash = 0;
+    size_t Size = 0;
+    bool Blocked = false;
+    bool HashOnly = false;
+    std::vector<char> Values;
+    std::vector<std::pair<const char*, size_t>> Arrays;
+  };
+
+  // Only the entry at timeCode and its direct neighbours keep their contents, which bounds the copies to about three per attribute.
+  // Entries without contents don't match any source, so a later commit next to them authors its own sample instead of sharing one.
+  void ReleaseSampleContents(UsdBridgeArraySampleCache::SampleContainer& samples, double timeCode)
+  {
+    auto keptIt = samples.find(timeCode);
+    if(keptIt == samples.end())
+      return;
+    auto prevIt = (keptIt == samples.begin()) ? samples.end() : std::prev(keptIt);
+    auto nextIt = std::next(keptIt);
+    for(auto it = samples.begin(); it != samples.end(); ++it)
+    {
+      if(it != keptIt && it != prevIt && it != nextIt)
+        it->second.Contents.reset();
+    }
+  }
+
+  // Returns whether the linearly interpolated value that USD resolves to at timeCode already equals the new sample, in which case
+  // no sample has to be authored. This holds if the entries directly before and after timeCode have the same contents, as all of the
+  // authored samples in between them are equal as well. Otherwise, the sample is recorded as authored, and directly neighbouring
+  // timesteps that share a sample with different contents are given their own copy of it, as they would interpolate towards the new sample.
+  // The copies are made from the current values, so the new sample has to be authored to the attribs after this function returns.
+  // The first attrib identifies the sample, further attribs which share its timesteps are optional.
+  bool ShareArraySample(UsdBridgePrimCache* cacheEntry, std::initializer_list<UsdAttribute> attribs, double timeCode, const ArraySampleSource& source)
+  {
+    if(!cacheEntry->ArraySampleCache)
+      cacheEntry->ArraySampleCache = std::make_unique<UsdBridgeArraySampleCache>();
+
+    const UsdAttribute& keyAttrib = *attribs.begin();
+    UsdBridgeArraySampleCache::SampleContainer& samples = cacheEntry->ArraySampleCache->Samples[keyAttrib.GetPath()];
+
+    auto sampleIt = samples.find(timeCode);
+    if(sampleIt != samples.end() && source.Matches(sampleIt->second))
+      return true;
+
+    auto nextIt = samples.upper_bound(timeCode);
+    auto prevIt = samples.lower_bound(timeCode);
+    bool hasPrev = (prevIt != samples.begin());
+    bool hasNext = (nextIt != samples.end());
+    if(hasPrev)
+      --prevIt;
+    bool prevMatches = hasPrev && source.Matches(prevIt->second);
+    bool nextMatches = hasNext && source.Matches(nextIt->second);
+
+    if(sampleIt == samples.end() && (hasPrev || hasNext) && (!hasPrev || prevMatches) && (!hasNext || nextMatches))
+    {
+      samples.emplace(timeCode, source.ToSample(false, prevMatches ? &prevIt->second : &nextIt->second));
+      ReleaseSampleContents(samples, timeCode);
+      return true;
+    }
+
+    auto materializeSample = [&attribs, &source](UsdBridgeArraySampleCache::SampleContainer::iterator it)
+    {
+      if(it->second.Authored || source.Matches(it->second))
+        return;
+      for(const UsdAttribute& attrib : attribs)
+      {
+        if(!attrib)
+          continue;
+        UsdBridgeSdfEditBatch::FlushLayer(attrib.GetStage()->GetRootLayer()); // The sample may still be a deferred edit
+        VtValue value;
+        if(!attrib.Get(&value, it->first))
+          value = SdfValueBlock();
+        attrib.Set(value, it->first);
+      }
+      it->second.Authored = true;
+    };
+    if(hasPrev)
+      materializeSample(prevIt);
+    if(hasNext)
+      materializeSample(nextIt);
+
+    samples[timeCode] = source.ToSample(true, prevMatches ? &prevIt->second : (nextMatches ? &nextIt->second : nullptr));
+    ReleaseSampleContents(samples, timeCode);
+    return false;
+  }
+
+  // Samples recorded while the attribute was time-varying no longer apply once it has been written as uniform data
+  void ResetArraySamples(UsdBridgePrimCache* cacheEntry, const UsdAttribute& keyAttrib)
+  {
+    if(cacheEntry->ArraySampleCache)
+      cacheEntry->ArraySampleCache->Samples.erase(keyAttrib.GetPath());
+  }
+
+  void BlockArraySample(const UsdBridgeSettings& settings, UsdBridgeRt& usdRtData, UsdBridgePrimCache* cacheEntry, bool timeVaryingUpdate,
+    std::initializer_list<UsdAttribute> attribs, const UsdTimeCode& timeCode)
+  {
+    if(ArraySampleSharingEnabled(settings, usdRtData, timeVaryingUpdate) && ShareArraySample(cacheEntry, attribs, timeCode.GetValue(), ArraySampleSource::Block()))
+      return;
+
+    for(const UsdAttribute& attrib : attribs)
+    {
+      if(attrib)
+        SetUsdAttributeValue(attrib, SdfValueBlock(), timeCode);
+    }
+  }
+
+  // Queues the uniform values of a member which has become dynamic for authoring at the timesteps it was written at as a static member,
+  // see UsdBridgeUsdWriter::SplitStaticGeometryMembers(). With recordSamples, the back-filled samples are recorded as authored, so later timesteps can share them.
+  // Has to be called before the uniform attribs are cleared.
+  template<typename DMI>
+  void BackFillStaticMember(UsdBridgePrimCache* cacheEntry, DMI memberId, std::initializer_list<UsdAttribute> uniformAttribs, bool recordSamples = true)
+  {
+    if(!cacheEntry->ArraySampleCache)
+      return;
+    UsdBridgeArraySampleCache& sampleCache = *cacheEntry->ArraySampleCache;
+
+    auto memberIt = sampleCache.StaticMembers.find(static_cast<uint32_t>(memberId));
+    if(memberIt == sampleCache.StaticMembers.end() || !memberIt->second.Dynamic || memberIt->second.TimeSteps.empty())
+      return;
+    UsdBridgeArraySampleCache::StaticMember& staticMember = memberIt->second;
+
+    UsdBridgeSdfEditBatch::FlushLayer(uniformAttribs.begin()->GetStage()->GetRootLayer()); // The uniform value may still be a deferred edit
+    for(const UsdAttribute& uniformAttrib : uniformAttribs)
+    {
+      VtValue value;
+      if(!uniformAttrib || !uniformAttrib.Get(&value, UsdTimeCode::Default()))
+        continue;
+      sampleCache.BackFills.push_back({uniformAttrib, std::move(value), staticMember.TimeSteps});
+    }
+
+    if(shareTimeSamples && recordSamples)
+    {
+      UsdBridgeArraySampleCache::SampleContainer& samples = sampleCache.Samples[uniformAttribs.begin()->GetPath()];
+      for(double timeStep : staticMember.TimeSteps)
+      {
+        ArraySample sample = staticMember.Sample;
+        sample.Authored = true;
+        samples[timeStep] = std::move(sample);
+      }
+    }
+    staticMember.TimeSteps.clear();
+    staticMember.Sample.Contents.reset(); // Dynamic from now on
+  }
+
+  // Source arrays of the sample of each member eligible for a static/dynamic split
+
+  template<typename UsdGeomType, typename GeomDataType>
+  ArraySampleSource GetPointsSampleSource(const GeomDataType& geomData)
+  {
+    if(!geomData.Points)
+      return ArraySampleSource::Block();
+    ArraySampleSource source;
+    source.AddArray(geomData.Points, geomData.PointsType, geomData.NumPoints);
+    if constexpr(ExtentIncludesRadii<UsdGeomType>())
+    {
+      // The extent is derived from the points and radii, so it shares its samples with the points
+      if(geomData.Scales)
+        source.AddArray(geomData.Scales, geomData.ScalesType, geomData.NumPoints);
+      else
+        source.AddValue(geomData.getUniformScale());
+    }
+    return source;
+  }
+
+  template<typename GeomDataType>
+  ArraySampleSource GetNormalsSampleSource(const GeomDataType& geomData, uint64_t numPrims)
+  {
+    if(!geomData.Normals)
+      return ArraySampleSource::Block();
+    ArraySampleSource source;
+    return source.AddArray(geomData.Normals, geomData.NormalsType, geomData.PerPrimNormals ? numPrims : geomData.NumPoints);
+  }
+
+  template<typename GeomDataType>
+  ArraySampleSource GetColorsSampleSource(const GeomDataType& geomData, uint64_t numPrims)
+  {
+    if(!geomData.Colors)
+      return ArraySampleSource::Block();
+    ArraySampleSource source;
+    return source.AddArray(geomData.Colors, geomData.ColorsType, geomData.PerPrimColors ? numPrims : geomData.NumPoints);
+  }
+
+  template<typename GeomDataType>
+  ArraySampleSource GetAttributeSampleSource(const GeomDataType& geomData, uint32_t attribIndex, uint64_t numPrims)
+  {
+    const UsdBridgeAttribute& bridgeAttrib = geomData.Attributes[attribIndex];
+    if(!bridgeAttrib.Data)
+      return ArraySampleSource::Block();
+    ArraySampleSource source;
+    return source.AddArray(bridgeAttrib.Data, bridgeAttrib.DataType, bridgeAttrib.PerPrimData ? numPrims : geomData.NumPoints);
+  }
+
+  // The topology is compared by its hash and size only, as it can be large and doesn't change for most time-varying meshes
+  ArraySampleSource GetTopologySampleSource(const UsdBridgeMeshData& geomData, uint64_t numPrims)
+  {
+    ArraySampleSource source;
+    source.AddValue(numPrims);
+    if(geomData.Indices)
+      source.AddArray(geomData.Indices, geomData.IndicesType, geomData.NumIndices);
+    else
+      source.AddValue(geomData.NumIndices); // Consecutive indices
+    return source.CompareHashOnly();
+  }
+
+  uint64_t GetNumGeomPrims(const UsdBridgeMeshData& geomData) { return geomData.NumIndices / geomData.FaceVertexCount; }
+  uint64_t GetNumGeomPrims(const UsdBridgeInstancerData& geomData) { return geomData.NumPoints; }
+  uint64_t GetNumGeomPrims(const UsdBridgeCurveData& geomData) { return geomData.NumCurveLengths; }
+
+  // Keeps time-varying members as uniform data for as long as their contents equal those of the first timestep they were written at,
+  // so only the changing members are authored per timestep. Once the contents differ, the member is dynamic for the rest of the session.
+  // Static members have their time-varying bits cleared in geomData; with clip retiming, their unchanged uniform values are not authored again either,
+  // so clip stages only hold the members which actually change. Mesh topology is always split off, the other members only with usd::timeSampleSharing.
+  template<typename UsdGeomType, typename GeomDataType>
+  void SplitStaticGeometryMembers_Impl(const UsdBridgeSettings& settings, UsdBridgePrimCache* cacheEntry, GeomDataType& geomData, double timeStep)
+  {
+    using DMI = typename GeomDataType::DataMemberId;
+
+    uint64_t numPrims = GetNumGeomPrims(geomData);
+    UsdBridgeUpdateEvaluator<const GeomDataType> updateEval(geomData);
+
+    auto splitMember = [&](DMI memberId, auto getSource)
+    {
+      uint32_t memberKey = static_cast<uint32_t>(memberId);
+      bool timeVarying = ((geomData.TimeVarying & memberId) != DMI::NONE);
+      if(!timeVarying)
+      {
+        // Uniform by request, so the member starts out static again once it becomes time-varying
+        if(cacheEntry->ArraySampleCache)
+          cacheEntry->ArraySampleCache->StaticMembers.erase(memberKey);
+        return;
+      }
+
+      if(!cacheEntry->ArraySampleCache)
+        cacheEntry->ArraySampleCache = std::make_unique<UsdBridgeArraySampleCache>();
+      UsdBridgeArraySampleCache::StaticMember& staticMember = cacheEntry->ArraySampleCache->StaticMembers[memberKey];
+      if(staticMember.Dynamic)
+        return;
+
+      bool performsUpdate = updateEval.PerformsUpdate(memberId);
+      bool firstSample = staticMember.TimeSteps.empty();
+      if(performsUpdate)
+      {
+        ArraySampleSource source = getSource();
+        if(firstSample)
+          staticMember.Sample = source.ToSample(true);
+        else if(!source.Matches(staticMember.Sample))
+        {
+          // The member keeps its time-varying bit from now on; the update queues the uniform value for the earlier timesteps
+          staticMember.Dynamic = true;
+          staticMember.TimeSteps.erase(std::remove(staticMember.TimeSteps.begin(), staticMember.TimeSteps.end(), timeStep), staticMember.TimeSteps.end());
+          return;
+        }
+      }
+      else if(firstSample)
+        return; // Nothing to compare against yet, so the member is written as time-varying
+
+      auto timeIt = std::lower_bound(staticMember.TimeSteps.begin(), staticMember.TimeSteps.end(), timeStep);
+      if(timeIt == staticMember.TimeSteps.end() || *timeIt != timeStep)
+        staticMember.TimeSteps.insert(timeIt, timeStep);
+
+      geomData.TimeVarying = geomData.TimeVarying & ~memberId;
+#ifdef VALUE_CLIP_RETIMING
+      // The uniform value is kept in place on the scene stage prim
+      if(!firstSample)
+        geomData.UpdatesToPerform = geomData.UpdatesToPerform & ~memberId;
+#endif
+    };
+
+    if constexpr(std::is_same_v<GeomDataType, UsdBridgeMeshData>)
+      splitMember(DMI::INDICES, [&geomData, numPrims]() { return GetTopologySampleSource(geomData, numPrims); });
+
+    if(!settings.ShareTimeSamples)
+      return;
+
+    splitMember(DMI::POINTS, [&geomData]() { return GetPointsSampleSource<UsdGeomType>(geomData); });
+    if constexpr(!std::is_same_v<GeomDataType, UsdBridgeInstancerData>)
+      splitMember(DMI::NORMALS, [&geomData, numPrims]() { return GetNormalsSampleSource(geomData, numPrims); });
+    splitMember(DMI::COLORS, [&geomData, numPrims]() { return GetColorsSampleSource(geomData, numPrims); });
+
+    bool hasStTexCoords = settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData);
+    for(uint32_t attribIndex = 0; attribIndex < geomData.NumAttributes; ++attribIndex)
+    {
+      // Texture coordinates and quantized attributes author additional attributes per sample, which are not split off
+      const UsdBridgeAttribute& bridgeAttrib = geomData.Attributes[attribIndex];
+      if(bridgeAttrib.DataType == UsdBridgeType::UNDEFINED || (attribIndex == 0 && hasStTexCoords)
+        || UsdBridgeArrays::IsQuantizedType(bridgeAttrib.DataType, bridgeAttrib.OutputPrecision))
+        continue;
+
+      splitMember(ubutils::GetAttribBit<DMI>(attribIndex), [&geomData, attribIndex, numPrims]() { return GetAttributeSampleSource(geomData, attribIndex, numPrims); });
+    }
+  }
+
+#ifdef TIME_BASED_CACHING
+  uint64_t GetMeshIndex(const UsdBridgeMeshData& meshData, uint64_t i)
+  {
+    if(!meshData.Indices)
+      return i; // Consecutive indices
+    switch(meshData.IndicesType)
+    {
+      case UsdBridgeType::INT: return static_cast<uint64_t>(static_cast<const int32_t*>(meshData.Indices)[i]);
+      case UsdBridgeType::UINT: return static_cast<const uint32_t*>(meshData.Indices)[i];
+      case UsdBridgeType::LONG: return static_cast<uint64_t>(static_cast<const int64_t*>(meshData.Indices)[i]);
+      case UsdBridgeType::ULONG: return static_cast<const uint64_t*>(meshData.Indices)[i];
+      default: return i;
+    }
+  }
+
+  // Calls visit(memberId, data, dataType, perFace) for each per-vertex or per-face array member of the mesh
+  template<typename VisitFunc>
+  void ForEachMeshElementArray(const UsdBridgeMeshData& meshData, VisitFunc visit)
+  {
+    using DMI = UsdBridgeMeshData::DataMemberId;
+
+    visit(DMI::POINTS, meshData.Points, meshData.PointsType, false);
+    visit(DMI::NORMALS, meshData.Normals, meshData.NormalsType, meshData.PerPrimNormals);
+    visit(DMI::COLORS, meshData.Colors, meshData.ColorsType, meshData.PerPrimColors);
+    visit(DMI::LINEARVELOCITIES, meshData.LinearVelocities, UsdBridgeType::FLOAT3, false);
+    for(uint32_t attribIndex = 0; attribIndex < meshData.NumAttributes; ++attribIndex)
+    {
+      const UsdBridgeAttribute& bridgeAttrib = meshData.Attributes[attribIndex];
+      visit(ubutils::GetAttribBit<DMI>(attribIndex), bridgeAttrib.Data, bridgeAttrib.DataType, bridgeAttrib.PerPrimData);
+    }
+  }
+
+  // Hashes the elements of the time-varying members per vertex and per face. Element hashes can only be compared between updates with the same layout hash.
+  uint64_t HashMeshElements(const UsdBridgeMeshData& meshData, uint64_t numFaces, std::vector<uint64_t>& vertexHashes, std::vector<uint64_t>& faceHashes)
+  {
+    using DMI = UsdBridgeMeshData::DataMemberId;
+
+    uint64_t layoutHash = ubutils::HashBytes(&meshData.NumPoints, sizeof(meshData.NumPoints), numFaces);
+    layoutHash = ubutils::HashBytes(&meshData.FaceVertexCount, sizeof(meshData.FaceVertexCount), layoutHash);
+    layoutHash = ubutils::HashBytes(&meshData.TimeVarying, sizeof(meshData.TimeVarying), layoutHash);
+
+    vertexHashes.assign(meshData.NumPoints, 0);
+    faceHashes.assign(numFaces, 0);
+
+    ForEachMeshElementArray(meshData, [&](DMI memberId, const void* data, UsdBridgeType dataType, bool perFace)
+    {
+      if((meshData.TimeVarying & memberId) == DMI::NONE)
+        return;
+
+      bool present = (data != nullptr);
+      layoutHash = ubutils::HashBytes(&present, sizeof(present), layoutHash);
+      layoutHash = ubutils::HashBytes(&dataType, sizeof(dataType), layoutHash);
+      layoutHash = ubutils::HashBytes(&perFace, sizeof(perFace), layoutHash);
+      if(!present)
+        return;
+
+      size_t eltSize = ubutils::UsdBridgeTypeSize(dataType);
+      const char* elements = static_cast<const char*>(data);
+      std::vector<uint64_t>& hashes = perFace ? faceHashes : vertexHashes;
+      for(size_t eltIdx = 0; eltIdx < hashes.size(); ++eltIdx)
+        hashes[eltIdx] = ubutils::HashBytes(elements + eltIdx*eltSize, eltSize, hashes[eltIdx]);
+    });
+
+    if((meshData.TimeVarying & DMI::INDICES) != DMI::NONE)
+    {
+      // A face with different vertices is a different element
+      int faceVertexCount = meshData.FaceVertexCount;
+      for(uint64_t faceIdx = 0; faceIdx < numFaces; ++faceIdx)
+      {
+        for(int vertIdx = 0; vertIdx < faceVertexCount; ++vertIdx)
+        {
+          uint64_t index = GetMeshIndex(meshData, faceIdx*faceVertexCount + vertIdx);
+          faceHashes[faceIdx] = ubutils::HashBytes(&index, sizeof(index), faceHashes[faceIdx]);
+        }
+      }
+    }
+
+    return layoutHash;
+  }
+
+  // Faces of the static prim which are hidden at a timestep, and the mesh data of the dynamic prim which holds them instead.
+  // The dynamic mesh data points to the compacted arrays it owns.
+  struct UsdMeshElementSplit
+  {
+    bool WritesReference = false; // The static prim is (re)written with the reference elements
+    VtIntArray HoleIndices;
+    UsdBridgeMeshData DynamicData;
+    std::vector<UsdBridgeAttribute> DynamicAttributes;
+    std::vector<int> DynamicIndices;
+    std::vector<std::vector<char>> DynamicArrays;
+  };
+
+  // Compares the elements of meshData against the reference elements, which are taken from meshData if there are none yet.
+  // A face is dynamic if its own elements differ or if any of its vertices do.
+  void SplitMeshElements(std::unique_ptr<UsdBridgeMeshElementCache>& elementCache, const UsdBridgeMeshData& meshData, UsdMeshElementSplit& split)
+  {
+    using DMI = UsdBridgeMeshData::DataMemberId;
+
+    uint64_t numPoints = meshData.NumPoints;
+    uint64_t numFaces = GetNumGeomPrims(meshData);
+    int faceVertexCount = meshData.FaceVertexCount;
+
+    std::vector<uint64_t> vertexHashes, faceHashes;
+    uint64_t layoutHash = HashMeshElements(meshData, numFaces, vertexHashes, faceHashes);
+
+    split.WritesReference = !elementCache;
+    if(split.WritesReference)
+    {
+      elementCache = std::make_unique<UsdBridgeMeshElementCache>();
+      elementCache->LayoutHash = layoutHash;
+      elementCache->NumFaces = numFaces;
+      elementCache->VertexHashes = std::move(vertexHashes);
+      elementCache->FaceHashes = std::move(faceHashes);
+    }
+
+    std::vector<uint64_t> dynamicFaces;
+    if(split.WritesReference)
+    {
+      // The reference has no dynamic elements
+    }
+    else if(layoutHash != elementCache->LayoutHash)
+    {
+      // Without correspondence to the reference elements, the static prim is hidden altogether
+      split.HoleIndices.resize(elementCache->NumFaces);
+      for(uint64_t faceIdx = 0; faceIdx < elementCache->NumFaces; ++faceIdx)
+        split.HoleIndices[faceIdx] = static_cast<int>(faceIdx);
+      dynamicFaces.resize(numFaces);
+      for(uint64_t faceIdx = 0; faceIdx < numFaces; ++faceIdx)
+        dynamicFaces[faceIdx] = faceIdx;
+    }
+    else
+    {
+      for(uint64_t faceIdx = 0; faceIdx < numFaces; ++faceIdx)
+      {
+        bool dynamicFace = faceHashes[faceIdx] != elementCache->FaceHashes[faceIdx];
+        for(int vertIdx = 0; vertIdx < faceVertexCount && !dynamicFace; ++vertIdx)
+        {
+          uint64_t index = GetMeshIndex(meshData, faceIdx*faceVertexCount + vertIdx);
+          dynamicFace = index < numPoints && vertexHashes[index] != elementCache->VertexHashes[index];
+        }
+
+        if(dynamicFace)
+        {
+          split.HoleIndices.push_back(static_cast<int>(faceIdx));
+          dynamicFaces.push_back(faceIdx);
+        }
+      }
+    }
+
+    // Compact the vertices of the dynamic faces, skipping faces with out-of-range indices
+    std::vector<int> vertexRemap(dynamicFaces.empty() ? 0 : numPoints, -1);
+    std::vector<uint64_t> dynamicVertices;
+    std::vector<uint64_t> writtenFaces;
+    split.DynamicIndices.reserve(dynamicFaces.size()*faceVertexCount);
+    for(uint64_t faceIdx : dynamicFaces)
+    {
+      uint64_t firstIndex = faceIdx*faceVertexCount;
+      bool validFace = true;
+      for(int vertIdx = 0; vertIdx < faceVertexCount; ++vertIdx)
+        validFace = validFace && GetMeshIndex(meshData, firstIndex + vertIdx) < numPoints;
+      if(!validFace)
+        continue;
+
+      for(int vertIdx = 0; vertIdx < faceVertexCount; ++vertIdx)
+      {
+        uint64_t index = GetMeshIndex(meshData, firstIndex + vertIdx);
+        if(vertexRemap[index] < 0)
+        {
+          vertexRemap[index] = static_cast<int>(dynamicVertices.size());
+          dynamicVertices.push_back(index);
+        }
+        split.DynamicIndices.push_back(vertexRemap[index]);
+      }
+      writtenFaces.push_back(faceIdx);
+    }
+
+    auto compactArray = [&split, &dynamicVertices, &writtenFaces](const void* data, UsdBridgeType dataType, bool perFace) -> const void*
+    {
+      const std::vector<uint64_t>& elements = perFace ? writtenFaces : dynamicVertices;
+      if(!data || elements.empty())
+        return data; // Empty arrays keep pointing to the source, so their members aren't mistaken for absent ones
+
+      size_t eltSize = ubutils::UsdBridgeTypeSize(dataType);
+      const char* srcElements = static_cast<const char*>(data);
+      split.DynamicArrays.emplace_back(elements.size()*eltSize);
+      char* dstElements = split.DynamicArrays.back().data();
+      for(uint64_t element : elements)
+      {
+        memcpy(dstElements, srcElements + element*eltSize, eltSize);
+        dstElements += eltSize;
+      }
+      return split.DynamicArrays.back().data();
+    };
+
+    UsdBridgeMeshData& dynamicData = split.DynamicData;
+    dynamicData = meshData;
+    dynamicData.TimeVarying = DMI::ALL;
+    dynamicData.UpdatesToPerform = DMI::ALL;
+    dynamicData.NumPoints = dynamicVertices.size();
+    dynamicData.Points = compactArray(meshData.Points, meshData.PointsType, false);
+    dynamicData.Normals = compactArray(meshData.Normals, meshData.NormalsType, meshData.PerPrimNormals);
+    dynamicData.Colors = compactArray(meshData.Colors, meshData.ColorsType, meshData.PerPrimColors);
+    dynamicData.LinearVelocities = static_cast<const float*>(compactArray(meshData.LinearVelocities, UsdBridgeType::FLOAT3, false));
+
+    split.DynamicAttributes.assign(meshData.Attributes, meshData.Attributes + meshData.NumAttributes);
+    for(UsdBridgeAttribute& bridgeAttrib : split.DynamicAttributes)
+      bridgeAttrib.Data = compactArray(bridgeAttrib.Data, bridgeAttrib.DataType, bridgeAttrib.PerPrimData);
+    dynamicData.Attributes = split.DynamicAttributes.data();
+
+    dynamicData.Indices = split.DynamicIndices.empty() ? nullptr : split.DynamicIndices.data();
+    dynamicData.IndicesType = UsdBridgeType::INT;
+    dynamicData.NumIndices = split.DynamicIndices.size();
+    dynamicData.Lods = nullptr;
+    dynamicData.NumLods = 0;
+  }
+#endif
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomPoints(UsdGeomUpdateArguments<GeomDataType>& updateArgs, UsdGeomUpdateAttribArgs<UsdGeomType>& attribArgs)
   {
@@ -385,12 +1174,18 @@ namespace
     using DMI = typename GeomDataType::DataMemberId;
 
     bool performsUpdate = updateEval.PerformsUpdate(DMI::POINTS);
+    bool performsExtentUpdate = performsUpdate || PerformsRadiiUpdate<UsdGeomType>(updateEval); // The extent also covers the radii
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::POINTS);
 
+    if(timeVaryingUpdate)
+      BackFillStaticMember(cacheEntry, DMI::POINTS, {UsdGeomGetPointsAttribute(uniformGeom), uniformGeom.GetExtentAttr()});
+    else
+      ResetArraySamples(cacheEntry, UsdGeomGetPointsAttribute(uniformGeom));
+
     ClearUsdAttributes(UsdGeomGetPointsAttribute(uniformGeom), UsdGeomGetPointsAttribute(timeVarGeom), timeVaryingUpdate);
     ClearUsdAttributes(uniformGeom.GetExtentAttr(), timeVarGeom.GetExtentAttr(), timeVaryingUpdate);
 
-    if (performsUpdate)
+    if (performsExtentUpdate)
     {
       if (!geomData.Points)
       {
@@ -401,33 +1196,169 @@ namespace
         UsdGeomType* outGeom = timeVaryingUpdate ? &timeVarGeom : &uniformGeom;
         UsdTimeCode timeCode = timeEval.Eval(DMI::POINTS);
 
-        // Points
-        UsdAttribute pointsAttr = UsdGeomGetPointsAttribute(*outGeom);
+        // Points
+        UsdAttribute pointsAttr = UsdGeomGetPointsAttribute(*outGeom);
+
+        const void* arrayData = geomData.Points;
+        size_t arrayNumElements = geomData.NumPoints;
+        UsdBridgeType arrayDataType = geomData.PointsType;
+
+        const void* radii = nullptr;
+        UsdBridgeType radiiType = UsdBridgeType::UNDEFINED;
+        float uniformRadius = 0.0f;
+        GetExtentRadii<UsdGeomType>(logObj, geomData, radii, radiiType, uniformRadius);
+
+        // Float and double points are converted to the attribute in the same pass as the extent computation
+        bool fuseExtent = (arrayDataType == UsdBridgeType::FLOAT3 || arrayDataType == UsdBridgeType::DOUBLE3);
+
+        if(!performsUpdate)
+        {
+          // Only the radii have changed, so the points are left as they are (or skipped, see usd::positionInterval)
+          VtVec3fArray pointsArray;
+          GfRange3f extent;
+          if(!fuseExtent)
+            UsdBridgeSdfEditBatch::FlushLayer(pointsAttr.GetStage()->GetRootLayer());
+          if(fuseExtent)
+            extent = ComputePointsExtent(arrayData, arrayDataType, arrayNumElements, nullptr, radii, radiiType, uniformRadius);
+          else if(pointsAttr.Get(&pointsArray, timeCode))
+            extent = ComputePointsExtent(pointsArray.cdata(), UsdBridgeType::FLOAT3, pointsArray.size(), nullptr, radii, radiiType, uniformRadius);
+          else
+            return;
+
+          VtVec3fArray extentArray(2);
+          extentArray[0] = extent.GetMin();
+          extentArray[1] = extent.GetMax();
 
-        const void* arrayData = geomData.Points;
-        size_t arrayNumElements = geomData.NumPoints;
-        UsdBridgeType arrayDataType = geomData.PointsType;
+          SetUsdAttributeValue(outGeom->GetExtentAttr(), extentArray, timeCode);
+          return;
+        }
+
+        if(ArraySampleSharingEnabled(settings, usdRtData, timeVaryingUpdate)
+          && ShareArraySample(cacheEntry, {pointsAttr, outGeom->GetExtentAttr()}, timeCode.GetValue(), GetPointsSampleSource<UsdGeomType>(geomData)))
+          return;
 
-        UsdBridgeSpanI<GfVec3f>* pointSpan = UpdateUsdAttribute_Safe<GfVec3f>(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements, pointsAttr, timeCode);
+        UsdBridgeSpanI<GfVec3f>* pointSpan = UpdateUsdAttribute_Safe<GfVec3f>(usdRtData, logObj, fuseExtent ? nullptr : arrayData, arrayDataType, arrayNumElements,
+          pointsAttr, timeCode); // With nullptr as data, only the span is returned
 
-        // Usd requires extent.
         if(pointSpan)
         {
-          // Usd requires extent.
           GfRange3f extent;
-          for (GfVec3f& pt : *pointSpan) {
-            extent.UnionWith(pt);
+          if(fuseExtent)
+          {
+            extent = ComputePointsExtent(arrayData, arrayDataType, pointSpan->size(), pointSpan->begin(), radii, radiiType, uniformRadius);
+            pointSpan->AssignToAttrib();
           }
+          else
+            extent = ComputePointsExtent(pointSpan->begin(), UsdBridgeType::FLOAT3, pointSpan->size(), nullptr, radii, radiiType, uniformRadius);
+
+          // Usd requires extent.
           VtVec3fArray extentArray(2);
           extentArray[0] = extent.GetMin();
           extentArray[1] = extent.GetMax();
 
-          outGeom->GetExtentAttr().Set(extentArray, timeCode);
+          SetUsdAttributeValue(outGeom->GetExtentAttr(), extentArray, timeCode);
         }
       }
     }
   }
 
+#ifndef TIME_CLIP_STAGES
+  // Unchanged topology is written as uniform data, see SplitStaticGeometryMembers_Impl(). Once it has changed, clip stages hold
+  // a sample per timestep, whereas without clip stages, timesteps with the same topology still share a sample.
+  uint64_t GetTopologyHash(const UsdBridgeMeshData& meshData, uint64_t numPrims, int vertexCount)
+  {
+    uint64_t topologyHash = ubutils::HashBytes(&numPrims, sizeof(numPrims), static_cast<uint64_t>(vertexCount));
+    if(meshData.Indices)
+    {
+      bool longIndices = (meshData.IndicesType == UsdBridgeType::LONG || meshData.IndicesType == UsdBridgeType::ULONG);
+      size_t indexSize = longIndices ? sizeof(int64_t) : sizeof(int32_t);
+      topologyHash = ubutils::HashBytes(meshData.Indices, meshData.NumIndices*indexSize, topologyHash);
+    }
+    return topologyHash;
+  }
+
+  // Returns whether the topology at timeCode equals the sample that USD already resolves to at that time (int arrays have held interpolation),
+  // in which case no new sample has to be authored. Otherwise, the sample is recorded as authored, and timesteps sharing
+  // the previously resolved sample are given their own copy of it, as their resolved value would change once the new sample is written.
+  bool ShareTopologySample(UsdBridgePrimCache* cacheEntry, const UsdAttribute& countsAttr, const UsdAttribute& indicesAttr,
+    double timeCode, uint64_t topologyHash)
+  {
+    if(!cacheEntry->TopologyCache || cacheEntry->TopologyCache->PrimPath != countsAttr.GetPrimPath())
+    {
+      cacheEntry->TopologyCache = std::make_unique<UsdBridgeTopologyCache>();
+      cacheEntry->TopologyCache->PrimPath = countsAttr.GetPrimPath();
+    }
+    UsdBridgeTopologyCache::SampleContainer& samples = cacheEntry->TopologyCache->Samples;
+
+    UsdBridgeSdfEditBatch::FlushLayer(countsAttr.GetStage()->GetRootLayer()); // Samples are looked up and copied on the stage
+
+    auto sampleIt = samples.find(timeCode);
+    bool authoredAtTime = (sampleIt != samples.end() && sampleIt->second.Authored);
+    if(authoredAtTime && sampleIt->second.Hash == topologyHash)
+      return true;
+
+    double lowerTime, upperTime;
+    bool hasSamples = false;
+    countsAttr.GetBracketingTimeSamples(timeCode, &lowerTime, &upperTime, &hasSamples);
+    if(!hasSamples)
+    {
+      samples.clear(); // Samples have been cleared from the attribute
+      samples[timeCode] = {topologyHash, true};
+      return false;
+    }
+
+    if(!authoredAtTime)
+    {
+      // The lower bracketing sample is the resolved one, also for times before the first sample
+      auto resolvedIt = samples.find(lowerTime);
+      if(resolvedIt != samples.end() && resolvedIt->second.Authored && resolvedIt->second.Hash == topologyHash)
+      {
+        samples[timeCode] = {topologyHash, false};
+        return true;
+      }
+    }
+
+    auto copySample = [&countsAttr, &indicesAttr](double srcTime, double dstTime)
+    {
+      VtIntArray topoArray;
+      if(countsAttr.Get(&topoArray, srcTime))
+        countsAttr.Set(topoArray, dstTime);
+      if(indicesAttr.Get(&topoArray, srcTime))
+        indicesAttr.Set(topoArray, dstTime);
+    };
+
+    // Shared entries directly after timeCode all resolve to the same old sample, so copying it to the first one covers them all
+    auto nextIt = samples.upper_bound(timeCode);
+    if(nextIt != samples.end() && !nextIt->second.Authored && nextIt->second.Hash != topologyHash)
+    {
+      double oldTime;
+      countsAttr.GetBracketingTimeSamples(nextIt->first, &oldTime, &upperTime, &hasSamples);
+      bool resolvesToNewSample = !(oldTime > timeCode && oldTime <= nextIt->first); // No other sample in between
+      if(resolvesToNewSample)
+      {
+        copySample(oldTime, nextIt->first);
+        nextIt->second.Authored = true;
+      }
+    }
+
+    // Shared entries before the first sample resolve to it, which timeCode may replace as first sample
+    auto firstIt = samples.begin();
+    if(firstIt != samples.end() && firstIt->first < timeCode && !firstIt->second.Authored && firstIt->second.Hash != topologyHash)
+    {
+      double oldTime;
+      countsAttr.GetBracketingTimeSamples(firstIt->first, &oldTime, &upperTime, &hasSamples);
+      if(oldTime >= timeCode)
+      {
+        copySample(oldTime, firstIt->first);
+        firstIt->second.Authored = true;
+      }
+    }
+
+    samples[timeCode] = {topologyHash, true};
+    return false;
+  }
+#endif
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomIndices(UsdGeomUpdateArguments<GeomDataType>& updateArgs, UsdGeomUpdateAttribArgs<UsdGeomType>& attribArgs)
   {
@@ -437,6 +1368,10 @@ namespace
     bool performsUpdate = updateEval.PerformsUpdate(DMI::INDICES);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::INDICES);
 
+    // Samples of changing topology are shared by UsdBridgeTopologyCache instead
+    if(timeVaryingUpdate)
+      BackFillStaticMember(cacheEntry, DMI::INDICES, {uniformGeom.GetFaceVertexIndicesAttr(), uniformGeom.GetFaceVertexCountsAttr()}, false);
+
     ClearUsdAttributes(uniformGeom.GetFaceVertexIndicesAttr(), timeVarGeom.GetFaceVertexIndicesAttr(), timeVaryingUpdate);
     ClearUsdAttributes(uniformGeom.GetFaceVertexCountsAttr(), timeVarGeom.GetFaceVertexCountsAttr(), timeVaryingUpdate);
 
@@ -446,11 +1381,24 @@ namespace
       UsdTimeCode timeCode = timeEval.Eval(DMI::INDICES);
 
       uint64_t numIndices = geomData.NumIndices;
+      int vertexCount = numPrims ? numIndices / numPrims : geomData.FaceVertexCount;
 
-      // Face Vertex counts
       UsdAttribute faceVertCountsAttr = outGeom->GetFaceVertexCountsAttr();
-      int vertexCount = numIndices / numPrims;
+      UsdAttribute indicesAttr = outGeom->GetFaceVertexIndicesAttr();
+
+#ifndef TIME_CLIP_STAGES
+      // Deforming meshes typically keep their connectivity, in which case the topology sample of an earlier timestep is shared
+      if(timeVaryingUpdate && !usdRtData.ValidPrim())
+      {
+        uint64_t topologyHash = GetTopologyHash(geomData, numPrims, vertexCount);
+        if(ShareTopologySample(cacheEntry, faceVertCountsAttr, indicesAttr, timeCode.GetValue(), topologyHash))
+          return;
+      }
+      else if(cacheEntry->TopologyCache && cacheEntry->TopologyCache->PrimPath == outGeom->GetPath())
+        cacheEntry->TopologyCache.reset(); // Samples of the other prim of a split mesh are kept, see UsdBridgeMeshElementCache
+#endif
 
+      // Face Vertex counts
       UsdBridgeSpanI<int>* faceVertCountSpan = UpdateUsdAttribute_Safe<int>(usdRtData, logObj, nullptr, UsdBridgeType::INT, numPrims,
         faceVertCountsAttr, timeCode); // By passing a nullptr as data, only the span will be returned
 
@@ -466,7 +1414,6 @@ namespace
         const void* arrayData = geomData.Indices;
         UsdBridgeType arrayDataType = geomData.IndicesType;
         size_t arrayNumElements = numIndices;
-        UsdAttribute indicesAttr = outGeom->GetFaceVertexIndicesAttr();
 
         UsdBridgeSpanI<int>* indicesSpan = UpdateUsdAttribute_Safe<int>(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements,
           indicesAttr, timeCode);
@@ -482,6 +1429,137 @@ namespace
     }
   }
 
+  template<typename IndexType>
+  void CopyToIntArray(const void* data, size_t numElements, VtIntArray& outArray)
+  {
+    const IndexType* typedData = reinterpret_cast<const IndexType*>(data);
+    outArray.resize(numElements);
+    for(size_t i = 0; i < numElements; ++i)
+      outArray[i] = static_cast<int>(typedData[i]);
+  }
+
+  // Topology of the mesh data, as written by UpdateUsdGeomIndices
+  bool GetUsdGeomMeshTopology(const UsdBridgeMeshData& geomData, uint64_t numPrims, VtIntArray& faceVertCounts, VtIntArray& indices)
+  {
+    uint64_t numIndices = geomData.NumIndices;
+    if(geomData.Indices)
+    {
+      switch(geomData.IndicesType)
+      {
+        case UsdBridgeType::INT: CopyToIntArray<int32_t>(geomData.Indices, numIndices, indices); break;
+        case UsdBridgeType::UINT: CopyToIntArray<uint32_t>(geomData.Indices, numIndices, indices); break;
+        case UsdBridgeType::LONG: CopyToIntArray<int64_t>(geomData.Indices, numIndices, indices); break;
+        case UsdBridgeType::ULONG: CopyToIntArray<uint64_t>(geomData.Indices, numIndices, indices); break;
+        default: return false;
+      }
+    }
+    else
+    {
+      indices.resize(numIndices);
+      for(uint64_t i = 0; i < numIndices; ++i)
+        indices[i] = static_cast<int>(i);
+    }
+
+    faceVertCounts.assign(numPrims, numPrims ? static_cast<int>(numIndices / numPrims) : 0);
+    return true;
+  }
+
+  void RemoveUsdGeomLodVariants(const UsdPrim& prim)
+  {
+    SdfPrimSpecHandle primSpec = prim.GetStage()->GetEditTarget().GetPrimSpecForScenePath(prim.GetPath());
+    if(!primSpec)
+      return;
+
+    primSpec->RemoveVariantSet(constring::lodVariantSetName);
+    primSpec->GetVariantSetNameList().RemoveItemEdits(constring::lodVariantSetName);
+    primSpec->GetVariantSelections().erase(constring::lodVariantSetName);
+  }
+
+  void UpdateUsdGeomLodVariants(UsdGeomUpdateArguments<UsdBridgeMeshData>& updateArgs, UsdGeomUpdateAttribArgs<UsdGeomMesh>& attribArgs)
+  {
+    using GeomDataType = UsdBridgeMeshData;
+    using UsdGeomType = UsdGeomMesh;
+    UNPACK_UPDATE_ARGS UNPACK_ATTRIB_ARGS
+    using DMI = GeomDataType::DataMemberId;
+
+    UsdPrim prim = uniformGeom.GetPrim();
+    bool hasLodVariants = prim.GetVariantSets().HasVariantSet(constring::lodVariantSetName);
+
+    // The topology is read back and moved between the local opinion and the variants through the stage
+    UsdBridgeSdfEditBatch::FlushLayer(prim.GetStage()->GetRootLayer());
+    bool timeVaryingIndices = timeEval.IsTimeVarying(DMI::INDICES);
+
+    UsdAttribute faceVertCountsAttr = uniformGeom.GetFaceVertexCountsAttr();
+    UsdAttribute indicesAttr = uniformGeom.GetFaceVertexIndicesAttr();
+
+    // The topology that has just been written is taken from the mesh data; an unchanged topology
+    // composes from the local opinion or from the selected full variant
+    VtIntArray fullFaceVertCounts, fullIndices;
+    if(hasLodVariants || geomData.NumLods)
+    {
+      if(!updateEval.PerformsUpdate(DMI::INDICES) || !GetUsdGeomMeshTopology(geomData, numPrims, fullFaceVertCounts, fullIndices))
+      {
+        faceVertCountsAttr.Get(&fullFaceVertCounts);
+        indicesAttr.Get(&fullIndices);
+      }
+    }
+
+    if(geomData.NumLods == 0 || timeVaryingIndices || usdRtData.ValidPrim())
+    {
+      if(hasLodVariants)
+      {
+        if(geomData.NumLods && timeVaryingIndices)
+        {
+          UsdBridgeLogMacro(logObj, UsdBridgeLogLevel::WARNING, "Levels of detail of " << prim.GetPath().GetString()
+            << " removed: its topology has changed between timesteps, whereas the lod variants can only hold a single topology.");
+        }
+
+        SdfPropertySpecHandle localIndicesSpec = prim.GetStage()->GetEditTarget().GetPropertySpecForScenePath(indicesAttr.GetPath());
+        bool localTopology = localIndicesSpec && localIndicesSpec->HasDefaultValue();
+        RemoveUsdGeomLodVariants(prim);
+
+        // The full topology was only kept in its variant if it hasn't been updated since
+        if(!localTopology && !timeVaryingIndices)
+        {
+          faceVertCountsAttr.Set(fullFaceVertCounts);
+          indicesAttr.Set(fullIndices);
+        }
+      }
+      return;
+    }
+
+    // Local opinions are stronger than variant opinions, so the full topology moves into a variant of its own
+    faceVertCountsAttr.ClearDefault();
+    indicesAttr.ClearDefault();
+
+    if(hasLodVariants)
+      RemoveUsdGeomLodVariants(prim); // The number of levels may have changed
+
+    UsdVariantSet lodVariantSet = prim.GetVariantSets().AddVariantSet(constring::lodVariantSetName);
+    auto writeVariant = [&lodVariantSet, &faceVertCountsAttr, &indicesAttr](const std::string& variantName,
+      const VtIntArray& faceVertCounts, const VtIntArray& indices)
+    {
+      lodVariantSet.AddVariant(variantName);
+      lodVariantSet.SetVariantSelection(variantName);
+
+      UsdEditContext variantContext(lodVariantSet.GetVariantEditContext());
+      faceVertCountsAttr.Set(faceVertCounts);
+      indicesAttr.Set(indices);
+    };
+
+    writeVariant(constring::lodFullVariantName, fullFaceVertCounts, fullIndices);
+    for(uint32_t lodIdx = 0; lodIdx < geomData.NumLods; ++lodIdx)
+    {
+      const UsdBridgeMeshLod& lod = geomData.Lods[lodIdx];
+      VtIntArray lodIndices(lod.Indices, lod.Indices + lod.NumIndices);
+      VtIntArray lodFaceVertCounts(lod.NumIndices / 3, 3);
+
+      writeVariant(constring::lodVariantSetName + std::to_string(lodIdx+1), lodFaceVertCounts, lodIndices);
+    }
+
+    lodVariantSet.SetVariantSelection(constring::lodFullVariantName);
+  }
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomNormals(UsdGeomUpdateArguments<GeomDataType>& updateArgs, UsdGeomUpdateAttribArgs<UsdGeomType>& attribArgs)
   {
@@ -491,6 +1569,11 @@ namespace
     bool performsUpdate = updateEval.PerformsUpdate(DMI::NORMALS);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(DMI::NORMALS);
 
+    if(timeVaryingUpdate)
+      BackFillStaticMember(cacheEntry, DMI::NORMALS, {uniformGeom.GetNormalsAttr()});
+    else
+      ResetArraySamples(cacheEntry, uniformGeom.GetNormalsAttr());
+
     ClearUsdAttributes(uniformGeom.GetNormalsAttr(), timeVarGeom.GetNormalsAttr(), timeVaryingUpdate);
 
     if (performsUpdate)
@@ -506,7 +1589,10 @@ namespace
         UsdBridgeType arrayDataType = geomData.NormalsType;
         size_t arrayNumElements = geomData.PerPrimNormals ? numPrims : geomData.NumPoints;
 
-        UpdateUsdAttribute_Safe(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements, normalsAttr, timeCode);
+        bool sharesSample = ArraySampleSharingEnabled(settings, usdRtData, timeVaryingUpdate)
+          && ShareArraySample(cacheEntry, {normalsAttr}, timeCode.GetValue(), GetNormalsSampleSource(geomData, numPrims));
+        if(!sharesSample)
+          UpdateUsdAttribute_Safe(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements, normalsAttr, timeCode);
 
         // Per face or per-vertex interpolation. This will break timesteps that have been written before.
         TfToken normalInterpolation = geomData.PerPrimNormals ? UsdGeomTokens->uniform : UsdGeomTokens->vertex;
@@ -514,7 +1600,7 @@ namespace
       }
       else
       {
-        normalsAttr.Set(SdfValueBlock(), timeCode);
+        BlockArraySample(settings, usdRtData, cacheEntry, timeVaryingUpdate, {normalsAttr}, timeCode);
       }
     }
   }
@@ -556,11 +1642,29 @@ namespace
       }
       else
       {
-        texcoordPrimvar.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(texcoordPrimvar.GetAttr(), SdfValueBlock(), timeCode);
       }
     }
   }
 
+  void UpdateUsdGeomQuantizedAttribute(UsdBridgeRt& usdRtData, UsdBridgeUsdWriter* writer, const UsdBridgeAttribute& bridgeAttrib, size_t arrayNumElements,
+    const TfToken& attribToken, UsdGeomPrimvarsAPI& outPrimvars, UsdAttribute& attributePrimvar, UsdTimeCode& timeCode)
+  {
+    const UsdBridgeLogObject& logObj = writer->LogObject;
+    int numComponents = UsdBridgeTypeNumComponents(bridgeAttrib.DataType);
+    size_t numValues = arrayNumElements*numComponents;
+    float scales[4], offsets[4];
+
+    // Request the flattened span only, quantize into it and assign
+    UsdBridgeSpanI<uint8_t>* quantSpan = UpdateUsdAttribute_Safe<uint8_t>(usdRtData, logObj, nullptr, UsdBridgeType::UCHAR, numValues, attributePrimvar, timeCode);
+    if(quantSpan && UsdBridgeArrays::WriteToArrayQuantized<uint8_t, 255>(logObj, bridgeAttrib.Data, bridgeAttrib.DataType, arrayNumElements,
+      quantSpan->begin(), scales, offsets))
+    {
+      quantSpan->AssignToAttrib();
+      SetUsdGeomQuantParams(writer, outPrimvars, attribToken, numComponents, scales, offsets, timeCode);
+    }
+  }
+
   template<typename GeomDataType>
   void UpdateUsdGeomAttribute(UsdGeomUpdateArguments<GeomDataType>& updateArgs, UsdGeomUpdatePrimvarArgs& primvarArgs, uint32_t attribIndex)
   {
@@ -572,13 +1676,14 @@ namespace
     TfToken attribToken = bridgeAttrib.Name ? writer->AttributeNameToken(bridgeAttrib.Name) : AttribIndexToToken(attribIndex);
     UsdGeomPrimvar uniformPrimvar = uniformPrimvars.GetPrimvar(attribToken);
     // The uniform primvar has to exist, otherwise any timevarying data will be ignored as well
-    if(!uniformPrimvar || uniformPrimvar.GetTypeName() != UsdBridgeArrays::GetAttribArrayType(bridgeAttrib.DataType))
+    SdfValueTypeName primvarType = GetAttribOutputArrayType(bridgeAttrib);
+    if(!uniformPrimvar || uniformPrimvar.GetTypeName() != primvarType || uniformPrimvar.GetElementSize() != GetAttribOutputElementSize(bridgeAttrib))
     {
       CreateUsdGeomAttributePrimvar(writer, uniformPrimvars, geomData, attribIndex); // No timeEval, to force attribute primvar creation on the uniform api
     }
 
     UsdGeomPrimvar timeVarPrimvar = timeVarPrimvars.GetPrimvar(attribToken);
-    if(!timeVarPrimvar || timeVarPrimvar.GetTypeName() != UsdBridgeArrays::GetAttribArrayType(bridgeAttrib.DataType)) // even though new clipstages initialize the correct primvar type/name, it may still be wrong for existing ones (or primstages if so configured)
+    if(!timeVarPrimvar || timeVarPrimvar.GetTypeName() != primvarType || timeVarPrimvar.GetElementSize() != GetAttribOutputElementSize(bridgeAttrib)) // even though new clipstages initialize the correct primvar type/name, it may still be wrong for existing ones (or primstages if so configured)
     {
       CreateUsdGeomAttributePrimvar(writer, timeVarPrimvars, geomData, attribIndex, &timeEval);
     }
@@ -589,6 +1694,11 @@ namespace
     bool performsUpdate = updateEval.PerformsUpdate(attributeId);
     bool timeVaryingUpdate = timeEval.IsTimeVarying(attributeId);
 
+    if(timeVaryingUpdate)
+      BackFillStaticMember(cacheEntry, attributeId, {uniformPrimvar.GetAttr()});
+    else
+      ResetArraySamples(cacheEntry, uniformPrimvar.GetAttr());
+
     ClearUsdAttributes(uniformPrimvar.GetAttr(), timeVarPrimvar.GetAttr(), timeVaryingUpdate);
 
     if (performsUpdate)
@@ -608,7 +1718,18 @@ namespace
           const void* arrayData = bridgeAttrib.Data;
           size_t arrayNumElements = bridgeAttrib.PerPrimData ? numPrims : geomData.NumPoints;
 
-          UpdateUsdAttribute_Safe(usdRtData, writer->LogObject, arrayData, bridgeAttrib.DataType, arrayNumElements, attributePrimvar, timeCode);
+          if(UsdBridgeArrays::IsQuantizedType(bridgeAttrib.DataType, bridgeAttrib.OutputPrecision))
+          {
+            UsdGeomPrimvarsAPI& outPrimvars = timeVaryingUpdate ? timeVarPrimvars : uniformPrimvars;
+            UpdateUsdGeomQuantizedAttribute(usdRtData, writer, bridgeAttrib, arrayNumElements, attribToken, outPrimvars, attributePrimvar, timeCode);
+          }
+          else
+          {
+            bool sharesSample = ArraySampleSharingEnabled(settings, usdRtData, timeVaryingUpdate)
+              && ShareArraySample(cacheEntry, {attributePrimvar}, timeCode.GetValue(), GetAttributeSampleSource(geomData, attribIndex, numPrims));
+            if(!sharesSample)
+              UpdateUsdAttribute_Safe(usdRtData, writer->LogObject, arrayData, bridgeAttrib.DataType, arrayNumElements, attributePrimvar, timeCode);
+          }
 
 
           // Per face or per-vertex interpolation. This will break timesteps that have been written before.
@@ -617,7 +1738,7 @@ namespace
         }
         else
         {
-          attributePrimvar.Set(SdfValueBlock(), timeCode);
+          BlockArraySample(settings, usdRtData, cacheEntry, timeVaryingUpdate, {attributePrimvar}, timeCode);
         }
       }
     }
@@ -656,6 +1777,11 @@ namespace
       timeVarOpacityPrimvar = timeVarPrimvars.GetPrimvar(UsdBridgeTokens->displayOpacity);
     }
 
+    if(timeVaryingUpdate)
+      BackFillStaticMember(cacheEntry, DMI::COLORS, {uniformColorPrimvar.GetAttr(), uniformOpacityPrimvar.GetAttr()});
+    else
+      ResetArraySamples(cacheEntry, uniformColorPrimvar.GetAttr());
+
     ClearUsdAttributes(uniformColorPrimvar.GetAttr(), timeVarColorPrimvar.GetAttr(), timeVaryingUpdate);
     if(useDisplayColorOpacity)
       ClearUsdAttributes(uniformOpacityPrimvar.GetAttr(), timeVarOpacityPrimvar.GetAttr(), timeVaryingUpdate);
@@ -674,7 +1800,10 @@ namespace
         UsdBridgeType arrayDataType = geomData.ColorsType;
         assert(colorAttrib);
 
-        if(!useDisplayColorOpacity)
+        bool sharesSample = ArraySampleSharingEnabled(settings, usdRtData, timeVaryingUpdate)
+          && ShareArraySample(cacheEntry, {colorAttrib, opacityAttrib}, timeCode.GetValue(), GetColorsSampleSource(geomData, numPrims));
+
+        if(!sharesSample && !useDisplayColorOpacity)
         {
           // Get a span of type GfVec4f
           UsdBridgeSpanI<GfVec4f>* colorsSpan = UpdateUsdAttribute_Safe<GfVec4f>(usdRtData, writer->LogObject, nullptr, arrayDataType, arrayNumElements, colorAttrib, timeCode);
@@ -687,7 +1816,7 @@ namespace
             colorsSpan->AssignToAttrib();
           }
         }
-        else
+        else if(!sharesSample)
         {
           // Get spans for color and opacity
           UsdBridgeSpanI<GfVec3f>* colorsSpan = UpdateUsdAttribute_Safe<GfVec3f>(usdRtData, writer->LogObject, nullptr, arrayDataType, arrayNumElements, colorAttrib, timeCode);
@@ -711,9 +1840,7 @@ namespace
       }
       else
       {
-        colorAttrib.Set(SdfValueBlock(), timeCode);
-        if(useDisplayColorOpacity)
-          opacityAttrib.Set(SdfValueBlock(), timeCode);
+        BlockArraySample(settings, usdRtData, cacheEntry, timeVaryingUpdate, {colorAttrib, opacityAttrib}, timeCode);
       }
     }
   }
@@ -747,7 +1874,7 @@ namespace
       }
       else
       {
-        idsAttr.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(idsAttr, SdfValueBlock(), timeCode);
       }
     }
   }
@@ -778,7 +1905,7 @@ namespace
       // Remember that widths define a diameter, so a default width (1.0) corresponds to a scale of 0.5.
       if(!arrayData && geomData.getUniformScale() == 0.5f)
       {
-        widthsAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(widthsAttribute, SdfValueBlock(), timeCode);
       }
       else
       {
@@ -819,7 +1946,7 @@ namespace
 
       if(!geomData.Scales && usdbridgenumerics::isIdentity(geomData.Scale))
       {
-        scalesAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(scalesAttribute, SdfValueBlock(), timeCode);
       }
       else
       {
@@ -890,7 +2017,7 @@ namespace
       }
       else
       {
-        normalsAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(normalsAttribute, SdfValueBlock(), timeCode);
       }
     }
   }
@@ -917,7 +2044,7 @@ namespace
 
       if(!geomData.Orientations && usdbridgenumerics::isIdentity(geomData.Orientation))
       {
-        orientationsAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(orientationsAttribute, SdfValueBlock(), timeCode);
       }
       else
       {
@@ -993,6 +2120,17 @@ namespace
     }
   }
 
+  // Whether an absent array has to be blocked, as a value may have been authored before.
+  // A clip stage only holds a single timestep, so it cannot tell whether other timesteps hold a value.
+  bool BlocksAuthoredValue(const UsdAttribute& attrib, bool timeVaryingUpdate)
+  {
+#ifdef TIME_CLIP_STAGES
+    if(timeVaryingUpdate)
+      return true;
+#endif
+    return attrib.HasAuthoredValue();
+  }
+
   template<typename UsdGeomType, typename GeomDataType>
   void UpdateUsdGeomLinearVelocities(UsdGeomUpdateArguments<GeomDataType>& updateArgs, UsdGeomUpdateAttribArgs<UsdGeomType>& attribArgs)
   {
@@ -1021,9 +2159,9 @@ namespace
         UpdateUsdAttribute_Safe(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements, linearVelocitiesAttribute, timeCode);
 
       }
-      else
+      else if (BlocksAuthoredValue(linearVelocitiesAttribute, timeVaryingUpdate)) // Only block velocities that were written before
       {
-        linearVelocitiesAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(linearVelocitiesAttribute, SdfValueBlock(), timeCode);
       }
     }
   }
@@ -1056,9 +2194,9 @@ namespace
         UpdateUsdAttribute_Safe(usdRtData, logObj, arrayData, arrayDataType, arrayNumElements, angularVelocitiesAttribute, timeCode);
 
       }
-      else
+      else if (BlocksAuthoredValue(angularVelocitiesAttribute, timeVaryingUpdate))
       {
-        angularVelocitiesAttribute.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(angularVelocitiesAttribute, SdfValueBlock(), timeCode);
       }
     }
   }
@@ -1093,7 +2231,7 @@ namespace
       }
       else
       {
-        invisIdsAttr.Set(SdfValueBlock(), timeCode);
+        SetUsdAttributeValue(invisIdsAttr, SdfValueBlock(), timeCode);
       }
     }
   }
@@ -1126,9 +2264,89 @@ namespace
     }
   }
 
+  GfMatrix4d GetShapeMatrix(const UsdFloatMat4& shapeTransform)
+  {
+    const float* transform = shapeTransform.Data;
+    GfMatrix4d transMat;
+    transMat.SetRow(0, GfVec4d(GfVec4f(&transform[0])));
+    transMat.SetRow(1, GfVec4d(GfVec4f(&transform[4])));
+    transMat.SetRow(2, GfVec4d(GfVec4f(&transform[8])));
+    transMat.SetRow(3, GfVec4d(GfVec4f(&transform[12])));
+    return transMat;
+  }
+
+  void SetUsdShapeTransform(UsdGeomXformable& geomXformable, const UsdFloatMat4& shapeTransform)
+  {
+    geomXformable.ClearXformOpOrder();
+    if(!usdbridgenumerics::isIdentity(shapeTransform))
+    {
+      geomXformable.AddTransformOp().Set(GetShapeMatrix(shapeTransform));
+    }
+  }
+
+  bool HasUsdShapeTransform(const UsdGeomXformable& geomXformable, const UsdFloatMat4& shapeTransform)
+  {
+    bool resetsXformStack = false;
+    std::vector<UsdGeomXformOp> xformOps = geomXformable.GetOrderedXformOps(&resetsXformStack);
+    if(usdbridgenumerics::isIdentity(shapeTransform))
+      return xformOps.empty();
+
+    GfMatrix4d transMat;
+    return xformOps.size() == 1
+      && xformOps[0].GetOpType() == UsdGeomXformOp::TypeTransform
+      && xformOps[0].Get(&transMat)
+      && transMat == GetShapeMatrix(shapeTransform);
+  }
+
+  // Analytic prototype shapes are shared by all instancers through a library under the root class,
+  // with one entry per combination of shape type and shape transform.
+  SdfPath GetOrCreateLibraryShape(const UsdStagePtr& sceneStage, UsdBridgeInstancerRefData::InstanceShape shape, const UsdFloatMat4& shapeTransform)
+  {
+    TfType shapeType;
+    const char* shapeName = nullptr;
+    switch (shape)
+    {
+      case UsdBridgeInstancerRefData::SHAPE_SPHERE: shapeName = "sphere"; shapeType = TfType::Find<UsdGeomSphere>(); break;
+      case UsdBridgeInstancerRefData::SHAPE_CYLINDER: shapeName = "cylinder"; shapeType = TfType::Find<UsdGeomCylinder>(); break;
+      case UsdBridgeInstancerRefData::SHAPE_CONE: shapeName = "cone"; shapeType = TfType::Find<UsdGeomCone>(); break;
+      default: assert(false); break;
+    }
+
+    std::string libShapeName(constring::rootClassName);
+    libShapeName.append("/").append(constring::protoShapeLibraryName).append("/").append(shapeName);
+    if(!usdbridgenumerics::isIdentity(shapeTransform))
+      libShapeName.append("_").append(std::to_string(ubutils::HashBytes(shapeTransform.Data, sizeof(shapeTransform.Data))));
+
+    // The name only carries a hash of the transform, so an existing entry is a match if its authored transform is equal.
+    // On a collision, the next free or matching suffixed name is used.
+    SdfPath shapePath(libShapeName);
+    for(int collisionIdx = 1; ; ++collisionIdx)
+    {
+      UsdPrim shapePrim = sceneStage->GetPrimAtPath(shapePath);
+      if(!shapePrim)
+        break;
+      if(shapePrim.IsA(shapeType) && HasUsdShapeTransform(UsdGeomXformable(shapePrim), shapeTransform))
+        return shapePath;
+      shapePath = SdfPath(libShapeName + "_" + std::to_string(collisionIdx));
+    }
+
+    // All prototypes in USD are oriented lengthwise along the Z axis (relevant for cylinders and cones)
+    UsdGeomXformable geomXformable;
+    switch (shape)
+    {
+      case UsdBridgeInstancerRefData::SHAPE_SPHERE: geomXformable = UsdGeomSphere::Define(sceneStage, shapePath); break;
+      case UsdBridgeInstancerRefData::SHAPE_CYLINDER: geomXformable = UsdGeomCylinder::Define(sceneStage, shapePath); break;
+      case UsdBridgeInstancerRefData::SHAPE_CONE: geomXformable = UsdGeomCone::Define(sceneStage, shapePath); break;
+      default: break;
+    }
+    SetUsdShapeTransform(geomXformable, shapeTransform);
+
+    return shapePath;
+  }
+
   void UpdateUsdGeomPrototypes(const UsdBridgeLogObject& logObj, const UsdStagePtr& sceneStage, UsdGeomPointInstancer& uniformGeom,
     const UsdBridgeInstancerRefData& geomRefData, const SdfPrimPathList& protoGeomPaths,
-    const char* protoShapePathRp)
+    const char* protoShapePathRp, SdfPrimPathList& libShapePaths)
   {
     using DMI = typename UsdBridgeInstancerData::DataMemberId;
 
@@ -1142,54 +2360,27 @@ namespace
       SdfPath shapePath;
       if(geomRefData.Shapes[shapeIdx] != UsdBridgeInstancerRefData::SHAPE_MESH)
       {
+        // Prototypes have to be located below the instancer, so refer to the shared library shape from there.
+        // Instanceable, so the composed shape is shared between all instancers as well.
+        SdfPath libShapePath = GetOrCreateLibraryShape(sceneStage, geomRefData.Shapes[shapeIdx], geomRefData.ShapeTransform);
+        libShapePaths.push_back(libShapePath);
+
         std::string protoName = constring::protoShapePf + std::to_string(shapeIdx);
         shapePath = protoBasePath.AppendPath(SdfPath(protoName.c_str()));
+
+        UsdPrim protoPrim = sceneStage->DefinePrim(shapePath);
+        protoPrim.GetReferences().AddInternalReference(libShapePath);
+        protoPrim.SetInstanceable(true);
       }
       else
       {
+        // Mesh shapes are references to the shape geometry, with clip metadata specific to the instancer's shape timestep
         int protoGeomIdx = static_cast<int>(geomRefData.Shapes[shapeIdx]); // The mesh shape value is an index into protoGeomPaths
         assert(protoGeomIdx < protoGeomPaths.size());
         shapePath = protoGeomPaths[protoGeomIdx];
-      }
-
-      // All prototypes in USD are oriented lengthwise along the Z axis (relevant for cylinders and cones)
-      UsdGeomXformable geomXformable;
-      switch (geomRefData.Shapes[shapeIdx])
-      {
-        case UsdBridgeInstancerRefData::SHAPE_SPHERE:
-        {
-          geomXformable = UsdGeomSphere::Define(sceneStage, shapePath);
-          break;
-        }
-        case UsdBridgeInstancerRefData::SHAPE_CYLINDER:
-        {
-          geomXformable = UsdGeomCylinder::Define(sceneStage, shapePath);
-          break;
-        }
-        case UsdBridgeInstancerRefData::SHAPE_CONE:
-        {
-          geomXformable = UsdGeomCone::Define(sceneStage, shapePath);
-          break;
-        }
-        default:
-        {
-          geomXformable = UsdGeomXformable::Get(sceneStage, shapePath);
-          break;
-        }
-      }
 
-      // Add a transform
-      geomXformable.ClearXformOpOrder();
-      if(!usdbridgenumerics::isIdentity(geomRefData.ShapeTransform))
-      {
-        const float* transform = geomRefData.ShapeTransform.Data;
-        GfMatrix4d transMat;
-        transMat.SetRow(0, GfVec4d(GfVec4f(&transform[0])));
-        transMat.SetRow(1, GfVec4d(GfVec4f(&transform[4])));
-        transMat.SetRow(2, GfVec4d(GfVec4f(&transform[8])));
-        transMat.SetRow(3, GfVec4d(GfVec4f(&transform[12])));
-
-        geomXformable.AddTransformOp().Set(transMat);
+        UsdGeomXformable geomXformable = UsdGeomXformable::Get(sceneStage, shapePath);
+        SetUsdShapeTransform(geomXformable, geomRefData.ShapeTransform);
       }
 
       protoRel.AddTarget(shapePath);
@@ -1213,36 +2404,100 @@ UsdPrim UsdBridgeUsdWriter::InitializeUsdGeometry(UsdStageRefPtr geometryStage,
 }
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& meshData)
+void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& meshData)
 {
   TimeEvaluator<UsdBridgeMeshData> timeEval(meshData);
-  InitializeUsdGeometry_Impl(this, cacheEntry->ManifestStage.second, cacheEntry->PrimPath, meshData, false,
+  InitializeUsdGeometry_Impl(this, FindOrCreateManifestStage(cacheEntry).second, cacheEntry->PrimPath, meshData, false,
     Settings, &timeEval);
-
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& instancerData)
+void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& instancerData)
 {
   TimeEvaluator<UsdBridgeInstancerData> timeEval(instancerData);
-  InitializeUsdGeometry_Impl(this, cacheEntry->ManifestStage.second, cacheEntry->PrimPath, instancerData, false,
+  InitializeUsdGeometry_Impl(this, FindOrCreateManifestStage(cacheEntry).second, cacheEntry->PrimPath, instancerData, false,
     Settings, &timeEval);
-
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& curveData)
+void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& curveData)
 {
   TimeEvaluator<UsdBridgeCurveData> timeEval(curveData);
-  InitializeUsdGeometry_Impl(this, cacheEntry->ManifestStage.second, cacheEntry->PrimPath, curveData, false,
+  InitializeUsdGeometry_Impl(this, FindOrCreateManifestStage(cacheEntry).second, cacheEntry->PrimPath, curveData, false,
     Settings, &timeEval);
+}
+#endif
 
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
+void UsdBridgeUsdWriter::SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeMeshData& geomData, double timeStep) const
+{
+  // Split meshes keep their unchanged elements, and with them their unchanged members, in the static prim instead
+  if(!SplitsMeshElements(Settings))
+    SplitStaticGeometryMembers_Impl<UsdGeomMesh>(Settings, cacheEntry, geomData, timeStep);
+}
+
+void UsdBridgeUsdWriter::SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeInstancerData& geomData, double timeStep) const
+{
+  if(geomData.UseUsdGeomPoints)
+    SplitStaticGeometryMembers_Impl<UsdGeomPoints>(Settings, cacheEntry, geomData, timeStep);
+  else
+    SplitStaticGeometryMembers_Impl<UsdGeomPointInstancer>(Settings, cacheEntry, geomData, timeStep);
+}
+
+void UsdBridgeUsdWriter::SplitStaticGeometryMembers(UsdBridgePrimCache* cacheEntry, UsdBridgeCurveData& geomData, double timeStep) const
+{
+  SplitStaticGeometryMembers_Impl<UsdGeomBasisCurves>(Settings, cacheEntry, geomData, timeStep);
 }
+
+void UsdBridgeUsdWriter::BackFillStaticGeometryMembers(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry)
+{
+  if(!cacheEntry->ArraySampleCache || cacheEntry->ArraySampleCache->BackFills.empty())
+    return;
+
+  std::vector<UsdBridgeArraySampleCache::BackFill>& backFills = cacheEntry->ArraySampleCache->BackFills;
+#ifdef TIME_CLIP_STAGES
+  // Every timestep has its own clip stage, which is saved again if it isn't packed (packed stages are saved along with the scene)
+  std::vector<UsdStageRefPtr> modifiedStages;
+  for(const UsdBridgeArraySampleCache::BackFill& backFill : backFills)
+  {
+    for(double timeStep : backFill.TimeSteps)
+    {
+      const UsdStagePair* clipStage = FindClipStage(cacheEntry, timeStep);
+      UsdPrim clipPrim = clipStage ? clipStage->second->GetPrimAtPath(cacheEntry->PrimPath) : UsdPrim();
+      if(!clipPrim)
+      {
+        UsdBridgeLogMacro(this->LogObject, UsdBridgeLogLevel::WARNING, "Clip stage of timestep " << timeStep << " not found for " << cacheEntry->PrimPath.GetString()
+          << ", the value of " << backFill.UniformAttrib.GetName().GetString() << " at that timestep will be missing.");
+        continue;
+      }
+
+      const UsdAttribute& uniformAttrib = backFill.UniformAttrib;
+      UsdAttribute clipAttrib = clipPrim.GetAttribute(uniformAttrib.GetName());
+      if(!clipAttrib)
+        clipAttrib = clipPrim.CreateAttribute(uniformAttrib.GetName(), uniformAttrib.GetTypeName(), uniformAttrib.IsCustom());
+      clipAttrib.Set(backFill.Value, timeStep);
+
+      if(!Settings.PackClipStages && std::find(modifiedStages.begin(), modifiedStages.end(), clipStage->second) == modifiedStages.end())
+        modifiedStages.push_back(clipStage->second);
+    }
+  }
+
+  if(this->EnableSaving)
+  {
+    for(const UsdStageRefPtr& stage : modifiedStages)
+      SaveTimeVarStage(stage);
+  }
+#else
+  // The timesteps are all part of the same time-varying prim
+  UsdPrim timeVarPrim = timeVarStage->GetPrimAtPath(cacheEntry->PrimPath);
+  for(const UsdBridgeArraySampleCache::BackFill& backFill : backFills)
+  {
+    UsdAttribute timeVarAttrib = timeVarPrim.GetAttribute(backFill.UniformAttrib.GetName());
+    if(!timeVarAttrib)
+      continue;
+    for(double timeStep : backFill.TimeSteps)
+      timeVarAttrib.Set(backFill.Value, timeStep);
+  }
 #endif
+  backFills.clear();
+}
 
 #define UPDATE_USDGEOM_ATTRIB_ARRAYS(FuncDef) \
   FuncDef(updateArgs, attribArgs)
@@ -1250,7 +2505,69 @@ void UsdBridgeUsdWriter::UpdateUsdGeometryManifest(const UsdBridgePrimCache* cac
 #define UPDATE_USDGEOM_PRIMVAR_ARRAYS(FuncDef) \
   FuncDef(updateArgs, primvarArgs)
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep)
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeMeshData& geomData, double timeStep)
+{
+  const SdfPath& meshPath = cacheEntry->PrimPath;
+
+#ifdef TIME_BASED_CACHING
+  if(SplitsMeshElements(Settings))
+  {
+    typedef UsdBridgeMeshData::DataMemberId DMI;
+
+    SdfPath staticPath = meshPath.AppendPath(SdfPath(constring::staticElementsPrimPf));
+    SdfPath dynamicPath = meshPath.AppendPath(SdfPath(constring::dynamicElementsPrimPf));
+
+    if((geomData.TimeVarying & DMI::ALL) == DMI::NONE)
+    {
+      // The static prim holds the whole mesh, see InitializeUsdGeometry_Impl(); a later time-varying update writes a new reference
+      if(cacheEntry->MeshElementCache)
+      {
+        cacheEntry->MeshElementCache.reset();
+#ifndef VALUE_CLIP_RETIMING
+        // Uniform and time-varying prims are the same, so the samples of the split are cleared out
+        UsdBridgeSdfEditBatch::FlushLayer(timeVarStage->GetRootLayer());
+        for(const UsdAttribute& attrib : timeVarStage->GetPrimAtPath(dynamicPath).GetAttributes())
+        {
+          if(attrib.GetNumTimeSamples())
+            attrib.Clear();
+        }
+        UsdGeomMesh::Get(timeVarStage, staticPath).GetHoleIndicesAttr().Clear();
+#endif
+      }
+      UpdateUsdMesh(timeVarStage, cacheEntry, staticPath, geomData, timeStep);
+      return;
+    }
+
+    UsdMeshElementSplit split;
+    SplitMeshElements(cacheEntry->MeshElementCache, geomData, split);
+
+    // Once the reference has been written, the static prim only updates the members which are not time-varying
+    UsdBridgeMeshData staticData = geomData;
+    staticData.TimeVarying = DMI::NONE;
+    if(!split.WritesReference)
+      staticData.UpdatesToPerform = geomData.UpdatesToPerform & ~geomData.TimeVarying;
+    if(staticData.NumLods)
+    {
+      UsdBridgeLogMacro(this->LogObject, UsdBridgeLogLevel::WARNING, "Levels of detail of " << meshPath.GetString()
+        << " are not written, as the faces of its time-varying elements are split off into a separate prim (usd::timeSampleSharing).");
+      staticData.Lods = nullptr;
+      staticData.NumLods = 0;
+    }
+    UpdateUsdMesh(timeVarStage, cacheEntry, staticPath, staticData, timeStep);
+
+    UsdGeomMesh timeVarStaticGeom = UsdGeomMesh::Get(timeVarStage, staticPath);
+    assert(timeVarStaticGeom);
+    SetUsdAttributeValue(timeVarStaticGeom.CreateHoleIndicesAttr(), split.HoleIndices, UsdTimeCode(timeStep));
+
+    UpdateUsdMesh(timeVarStage, cacheEntry, dynamicPath, split.DynamicData, timeStep);
+    return;
+  }
+#endif
+
+  UpdateUsdMesh(timeVarStage, cacheEntry, meshPath, geomData, timeStep);
+}
+
+void UsdBridgeUsdWriter::UpdateUsdMesh(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const SdfPath& meshPath, const UsdBridgeMeshData& geomData, double timeStep)
 {
   // To avoid data duplication when using of clip stages, we need to potentially use the scenestage prim for time-uniform data.
   UsdGeomMesh uniformGeom = UsdGeomMesh::Get(this->SceneStage, meshPath);
@@ -1266,25 +2583,35 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
   TimeEvaluator<UsdBridgeMeshData> timeEval(geomData, timeStep);
 
   assert((geomData.NumIndices % geomData.FaceVertexCount) == 0);
-  uint64_t numPrims = int(geomData.NumIndices) / geomData.FaceVertexCount;
+  uint64_t numPrims = GetNumGeomPrims(geomData);
 
   UsdBridgeRt usdRtData(this->SceneStage, meshPath);
 
-  UsdGeomUpdateArguments<UsdBridgeMeshData> updateArgs = { usdRtData, geomData, Settings, numPrims, updateEval, timeEval };
+  UsdGeomUpdateArguments<UsdBridgeMeshData> updateArgs = { usdRtData, cacheEntry, geomData, Settings, numPrims, updateEval, timeEval };
   UsdGeomUpdateAttribArgs<UsdGeomMesh> attribArgs = { this->LogObject, timeVarGeom, uniformGeom };
   UsdGeomUpdatePrimvarArgs primvarArgs = { this, timeVarPrimvars, uniformPrimvars };
 
-  UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomPoints);
-  UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomNormals);
-  if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) )
-    { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
-  UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
-  UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomIndices);
+  {
+    // Batch the change notifications of all attribute updates into a single one
+    UsdBridgeSdfEditBatch editBatch;
+
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomPoints);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomNormals);
+    if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) )
+      { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
+    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
+    UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomIndices);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomLinearVelocities);
+  }
+  // Variant authoring edits the topology authored above through the stage, so it flushes the deferred edits of the prim's layer first
+  UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomLodVariants);
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& instancerPath, const UsdBridgeInstancerData& geomData, double timeStep)
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeInstancerData& geomData, double timeStep)
 {
+  const SdfPath& instancerPath = cacheEntry->PrimPath;
+
   UsdBridgeUpdateEvaluator<const UsdBridgeInstancerData> updateEval(geomData);
   TimeEvaluator<UsdBridgeInstancerData> timeEval(geomData, timeStep);
 
@@ -1292,7 +2619,9 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
 
   bool useGeomPoints = geomData.UseUsdGeomPoints;
 
-  uint64_t numPrims = geomData.NumPoints;
+  uint64_t numPrims = GetNumGeomPrims(geomData);
+
+  UsdBridgeSdfEditBatch editBatch; // Attribute values are authored on the layers within a single change block
 
   if (useGeomPoints)
   {
@@ -1304,7 +2633,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     assert(timeVarGeom);
     UsdGeomPrimvarsAPI timeVarPrimvars(timeVarGeom);
 
-    UsdGeomUpdateArguments<UsdBridgeInstancerData> updateArgs = { usdRtData, geomData, Settings, numPrims, updateEval, timeEval };
+    UsdGeomUpdateArguments<UsdBridgeInstancerData> updateArgs = { usdRtData, cacheEntry, geomData, Settings, numPrims, updateEval, timeEval };
     UsdGeomUpdateAttribArgs<UsdGeomPoints> attribArgs = { this->LogObject, timeVarGeom, uniformGeom };
     UsdGeomUpdatePrimvarArgs primvarArgs = { this, timeVarPrimvars, uniformPrimvars };
 
@@ -1312,6 +2641,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomInstanceIds);
     UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomWidths);
     UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomOrientNormals);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomLinearVelocities);
     if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) )
       { UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomTexCoords); }
     UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
@@ -1327,7 +2657,7 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     assert(timeVarGeom);
     UsdGeomPrimvarsAPI timeVarPrimvars(timeVarGeom);
 
-    UsdGeomUpdateArguments<UsdBridgeInstancerData> updateArgs = { usdRtData, geomData, Settings, numPrims, updateEval, timeEval };
+    UsdGeomUpdateArguments<UsdBridgeInstancerData> updateArgs = { usdRtData, cacheEntry, geomData, Settings, numPrims, updateEval, timeEval };
     UsdGeomUpdateAttribArgs<UsdGeomPointInstancer> attribArgs = { this->LogObject, timeVarGeom, uniformGeom };
     UsdGeomUpdatePrimvarArgs primvarArgs = { this, timeVarPrimvars, uniformPrimvars };
 
@@ -1340,14 +2670,16 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
     UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomAttributes);
     UPDATE_USDGEOM_PRIMVAR_ARRAYS(UpdateUsdGeomColors);
     UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomProtoIndices);
-    //UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomLinearVelocities);
-    //UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomAngularVelocities);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomLinearVelocities);
+    UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomAngularVelocities);
     UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomInvisibleIds);
   }
 }
 
-void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, const SdfPath& curvePath, const UsdBridgeCurveData& geomData, double timeStep)
+void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeCurveData& geomData, double timeStep)
 {
+  const SdfPath& curvePath = cacheEntry->PrimPath;
+
   // To avoid data duplication when using of clip stages, we need to potentially use the scenestage prim for time-uniform data.
   UsdGeomBasisCurves uniformGeom = UsdGeomBasisCurves::Get(this->SceneStage, curvePath);
   assert(uniformGeom);
@@ -1361,14 +2693,16 @@ void UsdBridgeUsdWriter::UpdateUsdGeometry(const UsdStagePtr& timeVarStage, cons
   UsdBridgeUpdateEvaluator<const UsdBridgeCurveData> updateEval(geomData);
   TimeEvaluator<UsdBridgeCurveData> timeEval(geomData, timeStep);
 
-  uint64_t numPrims = geomData.NumCurveLengths;
+  uint64_t numPrims = GetNumGeomPrims(geomData);
 
   UsdBridgeRt usdRtData(this->SceneStage, curvePath);
 
-  UsdGeomUpdateArguments<UsdBridgeCurveData> updateArgs = { usdRtData, geomData, Settings, numPrims, updateEval, timeEval };
+  UsdGeomUpdateArguments<UsdBridgeCurveData> updateArgs = { usdRtData, cacheEntry, geomData, Settings, numPrims, updateEval, timeEval };
   UsdGeomUpdateAttribArgs<UsdGeomBasisCurves> attribArgs = { this->LogObject, timeVarGeom, uniformGeom };
   UsdGeomUpdatePrimvarArgs primvarArgs = { this, timeVarPrimvars, uniformPrimvars };
 
+  UsdBridgeSdfEditBatch editBatch; // Attribute values are authored on the layers within a single change block
+
   UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomPoints);
   UPDATE_USDGEOM_ATTRIB_ARRAYS(UpdateUsdGeomNormals);
   if( Settings.EnableStTexCoords && UsdGeomDataHasTexCoords(geomData) )
@@ -1390,5 +2724,32 @@ void UsdBridgeUsdWriter::UpdateUsdInstancerPrototypes(const SdfPath& instancerPa
   }
 
   // Very basic rel update, without any timevarying aspects
-  UpdateUsdGeomPrototypes(this->LogObject, this->SceneStage, uniformGeom, geomRefData, refProtoGeomPrimPaths, protoShapePathRp);
+  SdfPrimPathList libShapePaths;
+  UpdateUsdGeomPrototypes(this->LogObject, this->SceneStage, uniformGeom, geomRefData, refProtoGeomPrimPaths, protoShapePathRp, libShapePaths);
+
+  // Reference the new library shapes before releasing the old ones, so shapes used by both are kept
+  for(const SdfPath& libShapePath : libShapePaths)
+    ++LibraryShapeRefCounts[libShapePath];
+  ReleaseLibraryShapes(instancerPath);
+  InstancerLibraryShapes[instancerPath] = std::move(libShapePaths);
+}
+
+void UsdBridgeUsdWriter::ReleaseLibraryShapes(const SdfPath& instancerPath)
+{
+  auto instancerIt = InstancerLibraryShapes.find(instancerPath);
+  if(instancerIt == InstancerLibraryShapes.end())
+    return;
+
+  for(const SdfPath& libShapePath : instancerIt->second)
+  {
+    auto refIt = LibraryShapeRefCounts.find(libShapePath);
+    assert(refIt != LibraryShapeRefCounts.end());
+    if(--refIt->second == 0)
+    {
+      LibraryShapeRefCounts.erase(refIt);
+      if(this->SceneStage->GetPrimAtPath(libShapePath))
+        this->SceneStage->RemovePrim(libShapePath);
+    }
+  }
+  InstancerLibraryShapes.erase(instancerIt);
 }
\ No newline at end of file
@@ -91,6 +91,7 @@ void UsdBridgeUsdWriter::UpdateUsdLight(UsdStageRefPtr timeVarStage, const SdfPa
   typedef typename UsdBridgeDirectionalLightData::DataMemberId DMI;
 
   const TimeEvaluator<UsdBridgeDirectionalLightData> timeEval(lightData, timeStep);
+  UsdBridgeSdfEditBatch editBatch;
   UsdLuxDistantLight lightPrim = UpdateUsdLightCommon<UsdBridgeDirectionalLightData, UsdLuxDistantLight>(
     timeVarStage, lightPrimPath, lightData, timeStep, timeVarHasChanged, timeEval);
 
@@ -126,6 +127,7 @@ void UsdBridgeUsdWriter::UpdateUsdLight(UsdStageRefPtr timeVarStage, const SdfPa
   typedef typename UsdBridgePointLightData::DataMemberId DMI;
 
   const TimeEvaluator<UsdBridgePointLightData> timeEval(lightData, timeStep);
+  UsdBridgeSdfEditBatch editBatch;
   UsdLuxSphereLight lightPrim = UpdateUsdLightCommon<UsdBridgePointLightData, UsdLuxSphereLight>(
     timeVarStage, lightPrimPath, lightData, timeStep, timeVarHasChanged, timeEval);
 
@@ -148,6 +150,7 @@ void UsdBridgeUsdWriter::UpdateUsdLight(UsdStageRefPtr timeVarStage, const SdfPa
   typedef typename UsdBridgeDomeLightData::DataMemberId DMI;
 
   const TimeEvaluator<UsdBridgeDomeLightData> timeEval(lightData, timeStep);
+  UsdBridgeSdfEditBatch editBatch;
   UsdLuxDomeLight lightPrim = UpdateUsdLightCommon<UsdBridgeDomeLightData, UsdLuxDomeLight>(
     timeVarStage, lightPrimPath, lightData, timeStep, timeVarHasChanged, timeEval);
 }
\ No newline at end of file
@@ -1149,9 +1149,9 @@ namespace
 UsdShadeMaterial UsdBridgeUsdWriter::InitializeIndexVolumeMaterial_Impl(UsdStageRefPtr volumeStage,
   const SdfPath& volumePath, bool uniformPrim, const TimeEvaluator<UsdBridgeVolumeData>* timeEval) const
 {
-  SdfPath indexMatPath = volumePath.AppendPath(SdfPath(constring::indexMaterialPf));
-  SdfPath indexShadPath = indexMatPath.AppendPath(SdfPath(constring::indexShaderPf));
-  SdfPath colorMapPath = indexMatPath.AppendPath(SdfPath(constring::indexColorMapPf));
+  SdfPath indexMatPath = volumePath.AppendPath(RelPrimPath(constring::indexMaterialPf));
+  SdfPath indexShadPath = indexMatPath.AppendPath(RelPrimPath(constring::indexShaderPf));
+  SdfPath colorMapPath = indexMatPath.AppendPath(RelPrimPath(constring::indexColorMapPf));
 
   UsdShadeMaterial indexMaterial = GetOrDefinePrim<UsdShadeMaterial>(volumeStage, indexMatPath);
   assert(indexMaterial);
@@ -1177,28 +1177,23 @@ UsdShadeMaterial UsdBridgeUsdWriter::InitializeIndexVolumeMaterial_Impl(UsdStage
 #endif
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::UpdateUsdMaterialManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeMaterialData& matData)
+void UsdBridgeUsdWriter::UpdateUsdMaterialManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeMaterialData& matData)
 {
   TimeEvaluator<UsdBridgeMaterialData> timeEval(matData);
-  InitializeUsdMaterial_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath, false,
+  UsdStageRefPtr manifestStage = FindOrCreateManifestStage(cacheEntry).second;
+  InitializeUsdMaterial_Impl(manifestStage, cacheEntry->PrimPath, false,
     Settings, &timeEval);
 
-  InitializeAttributeReaders_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath,
+  InitializeAttributeReaders_Impl(manifestStage, cacheEntry->PrimPath,
     Settings, matData, &timeEval);
-
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
 }
 
-void UsdBridgeUsdWriter::UpdateUsdSamplerManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData)
+void UsdBridgeUsdWriter::UpdateUsdSamplerManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData)
 {
   TimeEvaluator<UsdBridgeSamplerData> timeEval(samplerData);
 
-  InitializeSampler_Impl(cacheEntry->ManifestStage.second, cacheEntry->PrimPath, samplerData.Type,
+  InitializeSampler_Impl(FindOrCreateManifestStage(cacheEntry).second, cacheEntry->PrimPath, samplerData.Type,
     false, Settings, &timeEval);
-
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
 }
 #endif
 
@@ -1210,7 +1205,7 @@ void UsdBridgeUsdWriter::ConnectSamplersToMaterial(UsdStageRefPtr materialStage,
   // Essentially, this is an extension of UpdateShaderInput() for the case of param.Sampler
   if(Settings.EnablePreviewSurfaceShader)
   {
-    SdfPath shaderPrimPath = matPrimPath.AppendPath(SdfPath(constring::psShaderPrimPf));
+    SdfPath shaderPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::psShaderPrimPf));
 
     UsdShadeShader uniformShad, timeVarShad;
     GetMaterialCoreShader(this->SceneStage, materialStage, shaderPrimPath,
@@ -1237,8 +1232,8 @@ void UsdBridgeUsdWriter::ConnectSamplersToMaterial(UsdStageRefPtr materialStage,
   if(Settings.EnableMdlShader)
   {
     // Get shader prims
-    SdfPath shaderPrimPath = matPrimPath.AppendPath(SdfPath(constring::mdlShaderPrimPf));
-    SdfPath opMulPrimPath = matPrimPath.AppendPath(SdfPath(constring::mdlOpacityMulPrimPf));
+    SdfPath shaderPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::mdlShaderPrimPf));
+    SdfPath opMulPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::mdlOpacityMulPrimPf));
 
     UsdShadeShader uniformShad, timeVarShad;
     GetMaterialCoreShader(this->SceneStage, materialStage, shaderPrimPath,
@@ -1287,6 +1282,8 @@ void UsdBridgeUsdWriter::ConnectSamplersToMaterial(UsdStageRefPtr materialStage,
 
 void UsdBridgeUsdWriter::UpdateUsdMaterial(UsdStageRefPtr timeVarStage, const SdfPath& matPrimPath, const UsdBridgeMaterialData& matData, const UsdGeomPrimvarsAPI& boundGeomPrimvars, double timeStep)
 {
+  UsdBridgeSdfEditBatch editBatch; // Input values of both shaders are authored in one go
+
   // Update usd shader
   if(Settings.EnablePreviewSurfaceShader)
   {
@@ -1308,7 +1305,7 @@ void UsdBridgeUsdWriter::UpdatePsShader(UsdStageRefPtr timeVarStage, const SdfPa
   TimeEvaluator<UsdBridgeMaterialData> timeEval(matData, timeStep);
   typedef UsdBridgeMaterialData::DataMemberId DMI;
 
-  SdfPath shadPrimPath = matPrimPath.AppendPath(SdfPath(constring::psShaderPrimPf));
+  SdfPath shadPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::psShaderPrimPf));
 
   UsdShadeShader uniformShadPrim = UsdShadeShader::Get(SceneStage, shadPrimPath);
   assert(uniformShadPrim);
@@ -1343,14 +1340,14 @@ void UsdBridgeUsdWriter::UpdateMdlShader(UsdStageRefPtr timeVarStage, const SdfP
   TimeEvaluator<UsdBridgeMaterialData> timeEval(matData, timeStep);
   typedef UsdBridgeMaterialData::DataMemberId DMI;
 
-  SdfPath shadPrimPath = matPrimPath.AppendPath(SdfPath(constring::mdlShaderPrimPf));
+  SdfPath shadPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::mdlShaderPrimPf));
 
   UsdShadeShader uniformShadPrim = UsdShadeShader::Get(SceneStage, shadPrimPath);
   assert(uniformShadPrim);
   UsdShadeShader timeVarShadPrim = UsdShadeShader::Get(timeVarStage, shadPrimPath);
   assert(timeVarShadPrim);
 
-  SdfPath opMulPrimPath = matPrimPath.AppendPath(SdfPath(constring::mdlOpacityMulPrimPf));
+  SdfPath opMulPrimPath = matPrimPath.AppendPath(RelPrimPath(constring::mdlOpacityMulPrimPf));
 
   UsdShadeShader uniformOpMulPrim = UsdShadeShader::Get(SceneStage, opMulPrimPath);
   assert(uniformOpMulPrim);
@@ -1389,6 +1386,7 @@ void UsdBridgeUsdWriter::UpdateMdlShader(UsdStageRefPtr timeVarStage, const SdfP
 
 void UsdBridgeUsdWriter::UpdateUsdSampler(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeSamplerData& samplerData, double timeStep)
 {
+  UsdBridgeSdfEditBatch editBatch;
   TimeEvaluator<UsdBridgeSamplerData> timeEval(samplerData, timeStep);
   typedef UsdBridgeSamplerData::DataMemberId DMI;
 
@@ -1410,13 +1408,13 @@ void UsdBridgeUsdWriter::UpdateUsdSampler(UsdStageRefPtr timeVarStage, UsdBridge
 
   if(Settings.EnablePreviewSurfaceShader)
   {
-    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::psSamplerPrimPf));
+    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(RelPrimPath(constring::psSamplerPrimPf));
     UpdateSamplerInputs<true>(SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
   }
 
   if(Settings.EnableMdlShader)
   {
-    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::mdlSamplerPrimPf));
+    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(RelPrimPath(constring::mdlSamplerPrimPf));
     UpdateSamplerInputs<false>(SceneStage, timeVarStage, usdSamplerPrimPath, samplerData, imgFileName, attribNameToken, timeEval);
   }
 
@@ -1585,13 +1583,13 @@ void UsdBridgeUsdWriter::UpdateInAttribute(UsdStageRefPtr timeVarStage, const Sd
 
   if(Settings.EnablePreviewSurfaceShader)
   {
-    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::psSamplerPrimPf));
+    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(RelPrimPath(constring::psSamplerPrimPf));
     UpdateSamplerTcReader<true>(SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
   }
 
   if(Settings.EnableMdlShader)
   {
-    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(SdfPath(constring::mdlSamplerPrimPf));
+    SdfPath usdSamplerPrimPath = samplerPrimPath.AppendPath(RelPrimPath(constring::mdlSamplerPrimPf));
     UpdateSamplerTcReader<false>(SceneStage, timeVarStage, usdSamplerPrimPath, newNameToken, timeEval);
   }
 }
@@ -1602,8 +1600,8 @@ void UsdBridgeUsdWriter::UpdateIndexVolumeMaterial(UsdStageRefPtr sceneStage, Us
   TimeEvaluator<UsdBridgeVolumeData> timeEval(volumeData, timeStep);
   typedef UsdBridgeVolumeData::DataMemberId DMI;
 
-  SdfPath indexMatPath = volumePath.AppendPath(SdfPath(constring::indexMaterialPf));
-  SdfPath colorMapPath = indexMatPath.AppendPath(SdfPath(constring::indexColorMapPf));
+  SdfPath indexMatPath = volumePath.AppendPath(RelPrimPath(constring::indexMaterialPf));
+  SdfPath colorMapPath = indexMatPath.AppendPath(RelPrimPath(constring::indexColorMapPf));
 
   // Renormalize the value range based on the volume data type (see CopyToGrid in the volumewriter)
   GfVec2f valueRange(GfVec2d(volumeData.TfData.TfValueRange));
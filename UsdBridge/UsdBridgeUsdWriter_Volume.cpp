@@ -94,11 +94,11 @@ UsdPrim UsdBridgeUsdWriter::InitializeUsdVolume(UsdStageRefPtr volumeStage, cons
 }
 
 #ifdef VALUE_CLIP_RETIMING
-void UsdBridgeUsdWriter::UpdateUsdVolumeManifest(const UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData)
+void UsdBridgeUsdWriter::UpdateUsdVolumeManifest(UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData)
 {
   const SdfPath & volumePath = cacheEntry->PrimPath;
 
-  UsdStageRefPtr volumeStage = cacheEntry->ManifestStage.second;
+  UsdStageRefPtr volumeStage = FindOrCreateManifestStage(cacheEntry).second;
   TimeEvaluator<UsdBridgeVolumeData> timeEval(volumeData);
 
   InitializeUsdVolume_Impl(volumeStage, volumePath, 
@@ -107,15 +107,14 @@ void UsdBridgeUsdWriter::UpdateUsdVolumeManifest(const UsdBridgePrimCache* cache
 #ifdef USE_INDEX_MATERIALS
   InitializeIndexVolumeMaterial_Impl(volumeStage, volumePath, false, &timeEval);
 #endif
-
-  if(this->EnableSaving)
-    cacheEntry->ManifestStage.second->Save();
 }
 #endif
 
 void UsdBridgeUsdWriter::UpdateUsdVolume(UsdStageRefPtr timeVarStage, UsdBridgePrimCache* cacheEntry, const UsdBridgeVolumeData& volumeData, double timeStep)
 {
   const SdfPath& volPrimPath = cacheEntry->PrimPath;
+
+  UsdBridgeSdfEditBatch editBatch; // Covers the index material as well
   
   // Get the volume and ovdb field prims
   UsdVolVolume uniformVolume = UsdVolVolume::Get(SceneStage, volPrimPath);
@@ -123,7 +122,7 @@ void UsdBridgeUsdWriter::UpdateUsdVolume(UsdStageRefPtr timeVarStage, UsdBridgeP
   UsdVolVolume timeVarVolume = UsdVolVolume::Get(timeVarStage, volPrimPath);
   assert(timeVarVolume);
 
-  SdfPath ovdbFieldPath = volPrimPath.AppendPath(SdfPath(constring::openVDBPrimPf));
+  SdfPath ovdbFieldPath = volPrimPath.AppendPath(RelPrimPath(constring::openVDBPrimPf));
 
   UsdVolOpenVDBAsset uniformField = UsdVolOpenVDBAsset::Get(SceneStage, ovdbFieldPath);
   assert(uniformField);
@@ -24,6 +24,8 @@
 #include <pxr/base/gf/range3f.h>
 #include <pxr/base/gf/rotation.h>
 #include <pxr/base/gf/half.h>
+#include <pxr/base/work/loops.h>
+#include <pxr/base/work/reduce.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/notice.h>
 #include <pxr/usd/usd/stage.h>
@@ -32,6 +34,8 @@
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/clipsAPI.h>
 #include <pxr/usd/usd/inherits.h>
+#include <pxr/usd/usd/variantSets.h>
+#include <pxr/usd/usd/editContext.h>
 #include <pxr/usd/usdGeom/mesh.h>
 #include <pxr/usd/usdGeom/points.h>
 #include <pxr/usd/usdGeom/sphere.h>
@@ -51,7 +55,10 @@
 #include <pxr/usd/usdLux/shapingAPI.h>
 #include <pxr/usd/usdUtils/stageCache.h>
 #include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/usdShade/material.h>
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 #include <pxr/usd/kind/registry.h>
@@ -114,9 +114,16 @@ class UsdBridgedBaseObject : public UsdParameterizedBaseObject<T, D>
     UsdBridgedBaseObject(ANARIDataType t, const char* name, UsdDevice* device)
       : UsdParameterizedBaseObject<T, D>(t, device)
       , uniqueName(name)
+      , nameRegistry(device->getNameRegistry())
     {
     }
 
+    ~UsdBridgedBaseObject()
+    {
+      // Name can be reused by new objects after the device's usd::removeUnusedNames
+      nameRegistry->release(uniqueName);
+    }
+
     H getUsdHandle() const { return usdHandle; }
 
     const char* getName() const override { return this->getReadParams().usdName ? this->getReadParams().usdName->c_str() : uniqueName; }
@@ -213,6 +220,7 @@ class UsdBridgedBaseObject : public UsdParameterizedBaseObject<T, D>
     }
 
     const char* uniqueName;
+    std::shared_ptr<UsdUniqueNameRegistry> nameRegistry; // Keeps uniqueName valid, even if the object outlives the device
     H usdHandle;
     bool removePrim = false;
     
@@ -31,6 +31,7 @@ UsdDataArray::UsdDataArray(const void *appMemory,
   , deleterUserData(userData)
   , type(dataType)
   , isPrivate(false)
+  , arrayPool(device->getArrayPool())
 #ifdef CHECK_MEMLEAKS
   , allocDevice(device)
 #endif
@@ -51,6 +52,7 @@ UsdDataArray::UsdDataArray(ANARIDataType dataType, uint64_t numItems1, uint64_t
   : UsdParameterizedBaseObject<UsdDataArray, UsdDataArrayParams>(ANARI_ARRAY)
   , type(dataType)
   , isPrivate(true)
+  , arrayPool(device->getArrayPool())
 #ifdef CHECK_MEMLEAKS
   , allocDevice(device)
 #endif
@@ -198,11 +200,12 @@ void UsdDataArray::decRef(ANARIObject* anariObjects, uint64_t numAnariObjects)
   }
 }
 
-void UsdDataArray::allocPrivateData()
+void UsdDataArray::allocPrivateData(bool zeroInit)
 {
   // Alloc the owned memory
-  char* newData = new char[dataSizeInBytes];
-  memset(newData, 0, dataSizeInBytes);
+  void* newData = arrayPool->allocate(dataSizeInBytes);
+  if(zeroInit)
+    memset(newData, 0, dataSizeInBytes);
   data = newData;
 
 #ifdef CHECK_MEMLEAKS
@@ -218,8 +221,8 @@ void UsdDataArray::freePrivateData(bool mappedCopy)
   allocDevice->logRawDeallocation(memToFree);
 #endif
 
-  // Deallocate owned memory
-  delete[](char*)memToFree;
+  // Return owned memory to the pool
+  arrayPool->deallocate(memToFree, dataSizeInBytes);
   memToFree = nullptr;
 }
 
@@ -236,7 +239,7 @@ void UsdDataArray::publicToPrivateData()
 {
   // Alloc private dest, copy appMemory src to it
   const void* appMemory = data;
-  allocPrivateData();
+  allocPrivateData(false);
 
   std::memcpy(data, appMemory, dataSizeInBytes); // In case of object array, Refcount 'transfers' to the copy (splits off user-managed public refcount)
 
@@ -249,7 +252,7 @@ void UsdDataArray::CreateMappedObjectCopy()
 {
   // Move the original array to a different spot and allocate new memory for the mapped object array.
   mappedObjectCopy = data;
-  allocPrivateData();
+  allocPrivateData(false);
 
   // Transfer contents over to new memory, keep old one for managing references later on.
   std::memcpy(data, mappedObjectCopy, dataSizeInBytes);
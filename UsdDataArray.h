@@ -5,8 +5,11 @@
 
 #include "UsdBaseObject.h"
 #include "UsdParameterizedObject.h"
+#include "UsdDataArrayPool.h"
 #include "anari/frontend/anari_enums.h"
 
+#include <memory>
+
 class UsdDevice;
 
 struct UsdDataLayout
@@ -104,7 +107,7 @@ class UsdDataArray : public UsdParameterizedBaseObject<UsdDataArray, UsdDataArra
     void decRef(ANARIObject* anariObjects, uint64_t numAnariObjects);
 
     // Private memory management
-    void allocPrivateData();
+    void allocPrivateData(bool zeroInit = true); // Skip zero-init if contents will be overwritten immediately
     void freePrivateData(bool mappedCopy = false);
     void freePublicData(const void* appMemory);
     void publicToPrivateData();
@@ -123,6 +126,8 @@ class UsdDataArray : public UsdParameterizedBaseObject<UsdDataArray, UsdDataArra
 
     void* mappedObjectCopy;
 
+    std::shared_ptr<UsdDataArrayPool> arrayPool; // Pool of the device for private memory, shared in case the array outlives the device
+
 #ifdef CHECK_MEMLEAKS
     UsdDevice* allocDevice;
 #endif
@@ -0,0 +1,135 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UsdDataArrayPool.h"
+
+#include <new>
+
+namespace
+{
+  constexpr size_t minBlockSize = 256;
+  constexpr size_t largeBlockSize = size_t(2) << 20; // Large blocks are aligned to (and a multiple of) the huge page size
+  constexpr size_t defaultAlignment = 64;
+}
+
+UsdDataArrayPool::~UsdDataArrayPool()
+{
+  releaseCached();
+}
+
+size_t UsdDataArrayPool::sizeClassBytes(size_t numBytes)
+{
+  if(numBytes <= minBlockSize)
+    return minBlockSize;
+
+  if(numBytes >= largeBlockSize)
+    return ((numBytes + largeBlockSize - 1) / largeBlockSize) * largeBlockSize;
+
+  // Four size classes per power of two, which limits the internal fragmentation to 25%
+  size_t val = numBytes - 1;
+  size_t shift = 0;
+  while((val >> shift) >= 8)
+    ++shift;
+  return ((val >> shift) + 1) << shift;
+}
+
+void* UsdDataArrayPool::systemAllocate(size_t classBytes)
+{
+  size_t alignment = (classBytes >= largeBlockSize) ? largeBlockSize : defaultAlignment;
+  return ::operator new(classBytes, std::align_val_t(alignment));
+}
+
+void UsdDataArrayPool::systemDeallocate(void* ptr, size_t classBytes)
+{
+  size_t alignment = (classBytes >= largeBlockSize) ? largeBlockSize : defaultAlignment;
+  ::operator delete(ptr, std::align_val_t(alignment));
+}
+
+void* UsdDataArrayPool::allocate(size_t numBytes)
+{
+  size_t classBytes = sizeClassBytes(numBytes);
+
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    stats.bytesInUse += classBytes;
+
+    auto it = freeBlocks.find(classBytes);
+    if(it != freeBlocks.end() && !it->second.empty())
+    {
+      void* block = it->second.back();
+      it->second.pop_back();
+
+      stats.bytesCached -= classBytes;
+      ++stats.numReuses;
+
+      return block;
+    }
+
+    ++stats.numAllocations;
+  }
+
+  return systemAllocate(classBytes);
+}
+
+void UsdDataArrayPool::deallocate(void* ptr, size_t numBytes)
+{
+  if(!ptr)
+    return;
+
+  size_t classBytes = sizeClassBytes(numBytes);
+
+  std::lock_guard<std::mutex> lock(poolMutex);
+
+  stats.bytesInUse -= classBytes;
+
+  if(stats.bytesCached + classBytes <= maxCachedBytes)
+  {
+    freeBlocks[classBytes].push_back(ptr);
+    stats.bytesCached += classBytes;
+  }
+  else
+  {
+    systemDeallocate(ptr, classBytes);
+  }
+}
+
+void UsdDataArrayPool::releaseCached()
+{
+  std::lock_guard<std::mutex> lock(poolMutex);
+  trimCached(0);
+}
+
+void UsdDataArrayPool::setMaxCachedBytes(uint64_t maxBytes)
+{
+  std::lock_guard<std::mutex> lock(poolMutex);
+  maxCachedBytes = maxBytes;
+  trimCached(maxBytes);
+}
+
+UsdDataArrayPoolStats UsdDataArrayPool::getStats() const
+{
+  std::lock_guard<std::mutex> lock(poolMutex);
+  return stats;
+}
+
+void UsdDataArrayPool::trimCached(uint64_t maxBytes)
+{
+  auto it = freeBlocks.begin();
+  while(it != freeBlocks.end() && stats.bytesCached > maxBytes)
+  {
+    size_t classBytes = it->first;
+    std::vector<void*>& blocks = it->second;
+    while(!blocks.empty() && stats.bytesCached > maxBytes)
+    {
+      systemDeallocate(blocks.back(), classBytes);
+      blocks.pop_back();
+      stats.bytesCached -= classBytes;
+    }
+
+    if(blocks.empty())
+      it = freeBlocks.erase(it);
+    else
+      ++it;
+  }
+}
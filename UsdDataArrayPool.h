@@ -0,0 +1,54 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct UsdDataArrayPoolStats
+{
+  uint64_t bytesInUse = 0;      // Bytes handed out to data arrays (rounded up to size class)
+  uint64_t bytesCached = 0;     // Bytes kept in the free lists for reuse
+  uint64_t numAllocations = 0;  // Allocations served by the system allocator
+  uint64_t numReuses = 0;       // Allocations served from the free lists
+};
+
+// Pooled allocator for private UsdDataArray storage. Blocks are rounded up to size classes,
+// so that released blocks can be recycled by arrays of similar size, instead of thrashing the system allocator
+// for apps which create and release many (per-timestep) arrays every frame.
+// The pool is shared between the device and its arrays, so arrays can safely outlive the device.
+class UsdDataArrayPool
+{
+  public:
+    UsdDataArrayPool() = default;
+    ~UsdDataArrayPool();
+
+    UsdDataArrayPool(const UsdDataArrayPool&) = delete;
+    UsdDataArrayPool& operator=(const UsdDataArrayPool&) = delete;
+
+    // Contents of the returned memory are undefined
+    void* allocate(size_t numBytes);
+    void deallocate(void* ptr, size_t numBytes);
+
+    // Releases all cached blocks back to the system
+    void releaseCached();
+
+    void setMaxCachedBytes(uint64_t maxBytes);
+    UsdDataArrayPoolStats getStats() const;
+
+  protected:
+    static size_t sizeClassBytes(size_t numBytes);
+    static void* systemAllocate(size_t classBytes);
+    static void systemDeallocate(void* ptr, size_t classBytes);
+
+    void trimCached(uint64_t maxBytes);
+
+    mutable std::mutex poolMutex;
+    std::unordered_map<size_t, std::vector<void*>> freeBlocks; // Keyed by size class
+    UsdDataArrayPoolStats stats;
+    uint64_t maxCachedBytes = uint64_t(256) << 20;
+};
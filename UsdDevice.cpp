@@ -4,6 +4,7 @@
 #include "UsdDevice.h"
 #include "UsdBridgedBaseObject.h"
 #include "UsdDataArray.h"
+#include "UsdDataArrayPool.h"
 #include "UsdGeometry.h"
 #include "UsdSpatialField.h"
 #include "UsdSurface.h"
@@ -24,7 +25,8 @@
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
-#include <set>
+#include <string_view>
+#include <unordered_map>
 #include <memory>
 #include <sstream>
 #include <algorithm>
@@ -36,6 +38,8 @@
 
 static char deviceName[] = "usd";
 
+static constexpr size_t minInternedStringPruneSize = 1024;
+
 class UsdDeviceInternals
 {
 public:
@@ -57,6 +61,8 @@ public:
       deviceParams.outputMdlShader,
       deviceParams.useDisplayColorOpacity
     };
+    bridgeSettings.ShareTimeSamples = deviceParams.timeSampleSharing;
+    bridgeSettings.PackClipStages = deviceParams.packedClipStages;
 
 #ifdef USD_DEVICE_MPI_ENABLED
     if(!mpiController)
@@ -74,6 +80,7 @@ public:
 
     bridge->SetExternalSceneStage(externalSceneStage);
     bridge->SetEnableSaving(this->enableSaving);
+    bridge->SetMaxOpenClipStages(this->maxOpenClipStages);
 
     bridgeStatusFunc(UsdBridgeLogLevel::STATUS, userData, "Initializing UsdBridge Session");
 
@@ -94,13 +101,21 @@ public:
 
   std::string outputLocation;
   bool enableSaving = true;
+  uint64_t maxOpenClipStages = 1024;
+  double finalizedTimeStep = -std::numeric_limits<double>::infinity(); // Timesteps before this one are finalized in streaming mode
   std::unique_ptr<UsdBridge> bridge;
   SceneStagePtr externalSceneStage{nullptr};
 
   // MPI parallel support (KHR_DATA_PARALLEL_MPI)
   std::unique_ptr<UsdBridgeParallelController> mpiController;
 
-  std::set<std::string> uniqueNames;
+  std::shared_ptr<UsdUniqueNameRegistry> nameRegistry = std::make_shared<UsdUniqueNameRegistry>();
+
+  std::shared_ptr<UsdDataArrayPool> arrayPool = std::make_shared<UsdDataArrayPool>();
+
+  // Interned string parameter values, keyed by a view on the contents of the shared string itself
+  std::unordered_map<std::string_view, helium::IntrusivePtr<UsdSharedString>> internedStrings;
+  size_t internedStringPruneSize = minInternedStringPruneSize;
 };
 
 //---- Make sure to update clearDeviceParameters() on refcounted objects
@@ -115,6 +130,11 @@ DEFINE_PARAMETER_MAP(UsdDevice,
   REGISTER_PARAMETER_MACRO("usd::output.previewSurfaceShader", ANARI_BOOL, outputPreviewSurfaceShader)
   REGISTER_PARAMETER_MACRO("usd::output.mdlShader", ANARI_BOOL, outputMdlShader)
   REGISTER_PARAMETER_MACRO("usd::output.displayColorOpacity", ANARI_BOOL, useDisplayColorOpacity)
+  REGISTER_PARAMETER_MACRO("usd::geometryDedup", ANARI_BOOL, geometryDedup)
+  REGISTER_PARAMETER_MACRO("usd::instanceBatching", ANARI_BOOL, instanceBatching)
+  REGISTER_PARAMETER_MACRO("usd::streaming", ANARI_BOOL, streaming)
+  REGISTER_PARAMETER_MACRO("usd::timeSampleSharing", ANARI_BOOL, timeSampleSharing)
+  REGISTER_PARAMETER_MACRO("usd::clipStages.packed", ANARI_BOOL, packedClipStages)
 )
 
 void UsdDevice::clearDeviceParameters()
@@ -145,6 +165,8 @@ UsdDevice::~UsdDevice()
 
   clearResourceStringList(); // Do the same for resource string references
 
+  clearInternedStrings(); // Release the device's references to interned strings
+
   //internals->bridge->SaveScene(); //Uncomment to test cleanup of usd files.
 
 #ifdef CHECK_MEMLEAKS
@@ -242,10 +264,24 @@ void UsdDevice::filterSetParam(
     // Perform garbage collection on usd objects (needs to move into the user interface)
     if(internals->bridge)
       internals->bridge->GarbageCollect();
+
+    pruneInternedStrings();
+
+    internals->arrayPool->releaseCached();
+  }
+  else if(strEquals(name, "usd::export"))
+  {
+    if(type == ANARI_STRING && internals->bridge)
+    {
+      const char* exportDirectory = reinterpret_cast<const char*>(mem);
+      if(!internals->bridge->ExportScene(exportDirectory))
+        reportStatus(this, ANARI_DEVICE, ANARI_SEVERITY_ERROR, ANARI_STATUS_UNKNOWN_ERROR,
+          "UsdDevice failed to export the scene to '%s'", exportDirectory);
+    }
   }
   else if(strEquals(name, "usd::removeUnusedNames"))
   {
-    internals->uniqueNames.clear();
+    internals->nameRegistry->recycleReleased();
   }
   else if (strEquals(name, "usd::connection.logVerbosity")) // 0 <= verbosity <= USDBRIDGE_MAX_LOG_VERBOSITY, with USDBRIDGE_MAX_LOG_VERBOSITY being the loudest
   {
@@ -281,6 +317,20 @@ void UsdDevice::filterSetParam(
         internals->bridge->SetEnableSaving(internals->enableSaving);
     }
   }
+  else if (strEquals(name, "usd::clipStages.maxOpen"))
+  {
+    if(type == ANARI_UINT64)
+    {
+      internals->maxOpenClipStages = *(reinterpret_cast<const uint64_t*>(mem));
+      if(internals->bridge)
+        internals->bridge->SetMaxOpenClipStages(internals->maxOpenClipStages);
+    }
+  }
+  else if (strEquals(name, "usd::arrayPool.maxCachedBytes"))
+  {
+    if(type == ANARI_UINT64)
+      internals->arrayPool->setMaxCachedBytes(*(reinterpret_cast<const uint64_t*>(mem)));
+  }
   else if (strEquals(name, "statusCallback") && type == ANARI_STATUS_CALLBACK)
   {
     userSetStatusFunc = (ANARIStatusCallback)mem;
@@ -310,7 +360,10 @@ void UsdDevice::filterResetParam(const char * name)
     internals->mpiController.reset();
   }
   else if (!strEquals(name, "usd::garbageCollect")
-    && !strEquals(name, "usd::removeUnusedNames"))
+    && !strEquals(name, "usd::removeUnusedNames")
+    && !strEquals(name, "usd::export")
+    && !strEquals(name, "usd::arrayPool.maxCachedBytes")
+    && !strEquals(name, "usd::clipStages.maxOpen"))
   {
     resetParam(name);
   }
@@ -327,6 +380,19 @@ void UsdDevice::commit(UsdDevice* device)
 
   const UsdDeviceData& paramData = getReadParams();
   internals->bridge->UpdateBeginEndTime(paramData.timeStep);
+
+  if(paramData.streaming)
+  {
+    if(paramData.timeStep > internals->finalizedTimeStep)
+    {
+      internals->bridge->FinalizeTimeStepsBefore(paramData.timeStep);
+      internals->finalizedTimeStep = paramData.timeStep;
+    }
+    else if(paramData.timeStep < internals->finalizedTimeStep)
+      reportStatus(this, ANARI_DEVICE, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_OPERATION,
+        "UsdDevice 'usd::time' (%f) is earlier than the last committed timestep (%f), which has already been finalized with 'usd::streaming' enabled. Output at this timestep may be incomplete.",
+        paramData.timeStep, internals->finalizedTimeStep);
+  }
 }
 
 void UsdDevice::initializeBridge()
@@ -633,6 +699,11 @@ UsdBridge* UsdDevice::getUsdBridge()
   return internals->bridge.get();
 }
 
+const std::shared_ptr<UsdDataArrayPool>& UsdDevice::getArrayPool() const
+{
+  return internals->arrayPool;
+}
+
 void UsdDevice::renderFrame(ANARIFrame frame)
 {
   // Always commit device changes if not initialized, otherwise no conversion can be performed.
@@ -669,26 +740,17 @@ int UsdDevice::frameReady(ANARIFrame frame, ANARIWaitMask mask)
 
 const char* UsdDevice::makeUniqueName(const char* name)
 {
-  std::string proposedBaseName(name);
-  proposedBaseName.append("_");
-
-  int postFix = 0;
-  std::string proposedName = proposedBaseName + std::to_string(postFix);
-
-  auto empRes = internals->uniqueNames.emplace(proposedName);
-  while (!empRes.second)
-  {
-    ++postFix;
-    proposedName = proposedBaseName + std::to_string(postFix);
-    empRes = internals->uniqueNames.emplace(proposedName);
-  }
-
-  return empRes.first->c_str();
+  return internals->nameRegistry->acquire(name);
 }
 
 bool UsdDevice::nameExists(const char* name)
 {
-  return internals->uniqueNames.find(name) != internals->uniqueNames.end();
+  return internals->nameRegistry->contains(name);
+}
+
+const std::shared_ptr<UsdUniqueNameRegistry>& UsdDevice::getNameRegistry() const
+{
+  return internals->nameRegistry;
 }
 
 void UsdDevice::addToCommitList(UsdBaseObject* object, bool commitData)
@@ -703,12 +765,14 @@ void UsdDevice::addToCommitList(UsdBaseObject* object, bool commitData)
   }
   else
   {
-    auto it = std::find_if(commitList.begin(), commitList.end(),
-      [&object](const CommitListType& entry) -> bool { return entry.first.ptr == object; });
-    if(it == commitList.end())
+    auto empRes = commitListIndices.emplace(object, commitList.size());
+    if(empRes.second)
       commitList.emplace_back(CommitListType(object, commitData));
     else
-      it->second = it->second && commitData;
+    {
+      CommitListType& entry = commitList[empRes.first->second];
+      entry.second = entry.second && commitData;
+    }
   }
 }
 
@@ -724,16 +788,21 @@ void UsdDevice::clearCommitList()
 #endif
 
   commitList.resize(0);
+  commitListIndices.clear();
 }
 
 void UsdDevice::flushCommitList()
 {
   lockCommitList = true;
 
+  // Attribute values of all objects are written to the layers in one go, with a single round of change processing
+  internals->bridge->BeginEditBatch();
+
   writeTypeToUsd<(int)ANARI_SAMPLER>();
 
   writeTypeToUsd<(int)ANARI_SPATIAL_FIELD>();
   writeTypeToUsd<(int)ANARI_GEOMETRY>();
+  flushGeometryDedup();
   writeTypeToUsd<(int)ANARI_LIGHT>();
 
   writeTypeToUsd<(int)ANARI_MATERIAL>();
@@ -750,6 +819,11 @@ void UsdDevice::flushCommitList()
 
   removePrimsFromUsd();
 
+  internals->bridge->EndEditBatch();
+
+  // The scene stage is complete after every flush, also without saving it
+  internals->bridge->FlushClipMetaData();
+
   clearCommitList();
 
   lockCommitList = false;
@@ -757,9 +831,7 @@ void UsdDevice::flushCommitList()
 
 void UsdDevice::addToVolumeList(UsdVolume* volume)
 {
-  auto it = std::find(volumeList.begin(), volumeList.end(), volume);
-  if(it == volumeList.end())
-    volumeList.emplace_back(volume);
+  volumeList.insert(volume);
 }
 
 void UsdDevice::addToResourceStringList(UsdSharedString* string)
@@ -772,22 +844,157 @@ void UsdDevice::clearResourceStringList()
   resourceStringList.resize(0);
 }
 
+UsdSharedString* UsdDevice::internString(const char* str)
+{
+  auto& internedStrings = internals->internedStrings;
+
+  auto it = internedStrings.find(std::string_view(str));
+  if(it != internedStrings.end())
+    return it->second.ptr;
+
+  // Amortize the cleanup of strings which are no longer referenced by any parameter
+  if(internedStrings.size() >= internals->internedStringPruneSize)
+    pruneInternedStrings();
+
+  UsdSharedString* sharedStr = new UsdSharedString(str);
+#ifdef CHECK_MEMLEAKS
+  logStrAllocation(sharedStr);
+#endif
+
+  internedStrings.emplace(std::string_view(sharedStr->data), helium::IntrusivePtr<UsdSharedString>(sharedStr));
+  sharedStr->refDec(helium::RefType::PUBLIC); // Only the internal reference of the device remains
+
+  return sharedStr;
+}
+
+void UsdDevice::pruneInternedStrings()
+{
+  auto& internedStrings = internals->internedStrings;
+
+  auto it = internedStrings.begin();
+  while(it != internedStrings.end())
+  {
+    if(it->second.ptr->useCount() == 1) // Only referenced by the device itself
+    {
+#ifdef CHECK_MEMLEAKS
+      logStrDeallocation(it->second.ptr);
+#endif
+      it = internedStrings.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  internals->internedStringPruneSize = std::max(minInternedStringPruneSize, internedStrings.size()*2);
+}
+
+void UsdDevice::clearInternedStrings()
+{
+#ifdef CHECK_MEMLEAKS
+  for(auto& internedEntry : internals->internedStrings)
+  {
+    logStrDeallocation(internedEntry.second.ptr);
+  }
+#endif
+
+  internals->internedStrings.clear();
+  internals->internedStringPruneSize = minInternedStringPruneSize;
+}
+
 void UsdDevice::removeFromVolumeList(UsdVolume* volume)
 {
-  auto it = std::find(volumeList.begin(), volumeList.end(), volume);
-  if(it != volumeList.end())
+  volumeList.erase(volume);
+}
+
+UsdGeometry* UsdDevice::acquireDedupGeometry(uint64_t contentHash, UsdGeometry* geometry)
+{
+  dedupOrphans.erase(geometry);
+
+  GeometryDedupEntry& entry = geometryDedupTable[contentHash];
+  if(!entry.source)
+    entry.source = geometry;
+  else if(entry.source != geometry)
+  {
+    // Equal hashes do not guarantee equal contents
+    if(!geometry->hasEqualContent(entry.source))
+      return nullptr;
+    entry.duplicates.insert(geometry);
+  }
+
+  return entry.source;
+}
+
+void UsdDevice::releaseDedupGeometry(uint64_t contentHash, UsdGeometry* geometry)
+{
+  auto it = geometryDedupTable.find(contentHash);
+  if(it == geometryDedupTable.end())
+    return;
+
+  GeometryDedupEntry& entry = it->second;
+  if(entry.source == geometry)
+  {
+    // The duplicates lose their data, so they either find another source or author the data themselves during the next flush
+    for(UsdGeometry* duplicate : entry.duplicates)
+    {
+      duplicate->onDedupSourceReleased(this);
+      dedupOrphans.insert(duplicate);
+    }
+    geometryDedupTable.erase(it);
+  }
+  else
+  {
+    entry.duplicates.erase(geometry);
+  }
+}
+
+void UsdDevice::markDedupChanged(UsdGeometry* geometry)
+{
+  dedupChanged.insert(geometry);
+}
+
+void UsdDevice::removeFromDedupLists(UsdGeometry* geometry)
+{
+  dedupOrphans.erase(geometry);
+  dedupChanged.erase(geometry);
+}
+
+void UsdDevice::flushGeometryDedup()
+{
+  // Geometries which are removed during this flush release their duplicates now, so those are written within the same flush
+  for(UsdBaseObject* baseObj : removeList)
   {
-    *it = volumeList.back();
-    volumeList.pop_back();
+    if(baseObj->getType() == ANARI_GEOMETRY)
+      static_cast<UsdGeometry*>(baseObj)->releaseDedup(this);
+  }
+
+  if(dedupOrphans.size())
+  {
+    std::vector<UsdGeometry*> orphans(dedupOrphans.begin(), dedupOrphans.end());
+    dedupOrphans.clear();
+
+    for(UsdGeometry* orphan : orphans)
+      orphan->commitDedupOrphan(this);
+  }
+
+  if(dedupChanged.size())
+  {
+    // Surfaces have to reference the new source within this flush. Geometries have already been written,
+    // so the commit list can safely grow with the observers, which are all written after this point.
+    lockCommitList = false;
+    for(UsdGeometry* geometry : dedupChanged)
+      geometry->notify(geometry, this);
+    lockCommitList = true;
+
+    dedupChanged.clear();
   }
 }
 
 template<int typeInt>
 void UsdDevice::writeTypeToUsd()
 {
-  for(auto objCommitPair : commitList)
+  for(const auto& objCommitPair : commitList) // List is locked during flush, so no copies of the object pointers are required
   {
-    auto object = objCommitPair.first;
+    const auto& object = objCommitPair.first;
     bool commitData = objCommitPair.second;
 
     if((int)object->getType() == typeInt)
@@ -883,6 +1090,26 @@ int UsdDevice::getProperty(ANARIObject object,
       writeToVoidP(mem, anari::usd::query_extensions());
       return 1;
     }
+    else if (strEquals(name, "usd::arrayPool.bytesInUse") && type == ANARI_UINT64)
+    {
+      writeToVoidP(mem, internals->arrayPool->getStats().bytesInUse);
+      return 1;
+    }
+    else if (strEquals(name, "usd::arrayPool.bytesCached") && type == ANARI_UINT64)
+    {
+      writeToVoidP(mem, internals->arrayPool->getStats().bytesCached);
+      return 1;
+    }
+    else if (strEquals(name, "usd::arrayPool.numAllocations") && type == ANARI_UINT64)
+    {
+      writeToVoidP(mem, internals->arrayPool->getStats().numAllocations);
+      return 1;
+    }
+    else if (strEquals(name, "usd::arrayPool.numReuses") && type == ANARI_UINT64)
+    {
+      writeToVoidP(mem, internals->arrayPool->getStats().numReuses);
+      return 1;
+    }
   }
   else if(object)
     return AnariToUsdObjectPtr(object)->getProperty(name, type, mem, size, this);
@@ -6,9 +6,11 @@
 #include "anari/backend/DeviceImpl.h"
 #include "anari/backend/LibraryImpl.h"
 #include "UsdBaseObject.h"
+#include "UsdDeviceUtils.h"
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #ifdef _WIN32
 #ifdef anari_library_usd_EXPORTS
@@ -31,6 +33,8 @@ class UsdDevice;
 class UsdDeviceInternals;
 class UsdBaseObject;
 class UsdVolume;
+class UsdGeometry;
+class UsdDataArrayPool;
 
 struct UsdDeviceData
 {
@@ -46,6 +50,12 @@ struct UsdDeviceData
   bool outputPreviewSurfaceShader = true;
   bool outputMdlShader = true;
   bool useDisplayColorOpacity = false;
+
+  bool geometryDedup = false;
+  bool instanceBatching = false;
+  bool streaming = false;
+  bool timeSampleSharing = false;
+  bool packedClipStages = false;
 };
 
 class UsdDevice : public anari::DeviceImpl, public UsdParameterizedBaseObject<UsdDevice, UsdDeviceData>
@@ -220,6 +230,7 @@ class UsdDevice : public anari::DeviceImpl, public UsdParameterizedBaseObject<Us
     UsdBridge* getUsdBridge();
 
     bool nameExists(const char* name);
+    const std::shared_ptr<UsdUniqueNameRegistry>& getNameRegistry() const;
 
     void addToCommitList(UsdBaseObject* object, bool commitData);
     bool isFlushingCommitList() const { return lockCommitList; }
@@ -227,11 +238,25 @@ class UsdDevice : public anari::DeviceImpl, public UsdParameterizedBaseObject<Us
     void addToVolumeList(UsdVolume* volume);
     void removeFromVolumeList(UsdVolume* volume);
 
+    // Content-hash based sharing of geometry data (usd::geometryDedup). The first geometry to acquire a hash
+    // becomes the source which authors the data, other geometries with the same hash are its duplicates.
+    UsdGeometry* acquireDedupGeometry(uint64_t contentHash, UsdGeometry* geometry); // Returns the source for contentHash, or nullptr if its contents differ from geometry
+    void releaseDedupGeometry(uint64_t contentHash, UsdGeometry* geometry);
+    void markDedupChanged(UsdGeometry* geometry); // Observers of geometry have to update their references to its source
+    void removeFromDedupLists(UsdGeometry* geometry);
+
     // Allows for selected strings to persist,
     // so their pointers can be cached beyond their containing objects' lifetimes,
     // to be used for garbage collecting resource files.
     void addToResourceStringList(UsdSharedString* sharedString);
 
+    // Returns the device-wide shared string with the contents of str, creating it if it doesn't exist yet.
+    // The interned string is referenced by the device, so callers only have to increase the refcount if they hold on to it.
+    UsdSharedString* internString(const char* str);
+
+    // Allocator for private data array memory
+    const std::shared_ptr<UsdDataArrayPool>& getArrayPool() const;
+
 #ifdef CHECK_MEMLEAKS
     // Memleak checking
     void logObjAllocation(const UsdBaseObject* ptr);
@@ -276,8 +301,11 @@ class UsdDevice : public anari::DeviceImpl, public UsdParameterizedBaseObject<Us
 
     void clearCommitList();
     void flushCommitList();
+    void flushGeometryDedup();
     void clearDeviceParameters();
     void clearResourceStringList();
+    void pruneInternedStrings();
+    void clearInternedStrings();
 
     void initializeBridge();
 
@@ -308,8 +336,17 @@ class UsdDevice : public anari::DeviceImpl, public UsdParameterizedBaseObject<Us
     // so that's not 1-1 with the effects of a non-deferred commit order.
     using CommitListType = std::pair<helium::IntrusivePtr<UsdBaseObject>, bool>;
     std::vector<CommitListType> commitList;
+    std::unordered_map<UsdBaseObject*, size_t> commitListIndices; // Index into commitList for each object, to avoid linear searches
     std::vector<UsdBaseObject*> removeList;
-    std::vector<UsdVolume*> volumeList; // Tracks all volumes to auto-commit when child fields have been committed
+    UsdObjectRegistry<UsdVolume> volumeList; // Tracks all volumes to auto-commit when child fields have been committed
+    struct GeometryDedupEntry
+    {
+      UsdGeometry* source = nullptr;
+      UsdObjectRegistry<UsdGeometry> duplicates;
+    };
+    std::unordered_map<uint64_t, GeometryDedupEntry> geometryDedupTable;
+    UsdObjectRegistry<UsdGeometry> dedupOrphans; // Duplicates of which the source has been released
+    UsdObjectRegistry<UsdGeometry> dedupChanged; // Geometries of which the source has changed since the last flush
     bool lockCommitList = false;
 
     std::vector<helium::IntrusivePtr<UsdSharedString>> resourceStringList;
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 template<typename ValueType, typename ContainerType = std::vector<ValueType>>
 struct OptionalList
@@ -48,4 +51,131 @@ struct OptionalList
   }
 
   std::unique_ptr<ContainerType> list; 
-};
\ No newline at end of file
+};
+
+// Set of object pointers with O(1) insertion, removal and lookup, which can be iterated as a dense list.
+// Removal swaps the last element into the freed spot, so iteration order is not preserved.
+template<typename ObjectType>
+class UsdObjectRegistry
+{
+  public:
+    bool insert(ObjectType* object)
+    {
+      auto empRes = indices.emplace(object, objects.size());
+      if(empRes.second)
+        objects.push_back(object);
+      return empRes.second;
+    }
+
+    bool erase(ObjectType* object)
+    {
+      auto it = indices.find(object);
+      if(it == indices.end())
+        return false;
+
+      size_t index = it->second;
+      ObjectType* lastObject = objects.back();
+      objects[index] = lastObject;
+      indices[lastObject] = index;
+
+      objects.pop_back();
+      indices.erase(it);
+      return true;
+    }
+
+    bool contains(ObjectType* object) const { return indices.find(object) != indices.end(); }
+
+    void clear()
+    {
+      objects.resize(0);
+      indices.clear();
+    }
+
+    size_t size() const { return objects.size(); }
+    typename std::vector<ObjectType*>::const_iterator begin() const { return objects.begin(); }
+    typename std::vector<ObjectType*>::const_iterator end() const { return objects.end(); }
+
+  protected:
+    std::vector<ObjectType*> objects;
+    std::unordered_map<ObjectType*, size_t> indices;
+};
+
+// Generates unique names of the form <baseName>_<postfix>, with a next-free counter and free-list per base name.
+// Names of released objects only become available again after recycleReleased(), so a name is never
+// reused for a different object within the same session unless explicitly requested.
+class UsdUniqueNameRegistry
+{
+  public:
+    // Returned pointer stays valid until the name is recycled
+    const char* acquire(const char* baseName)
+    {
+      BaseNameEntry& baseEntry = baseNames[baseName];
+
+      std::string proposedName;
+      uint64_t postfix;
+      bool inserted = false;
+      do
+      {
+        if(!baseEntry.freePostfixes.empty())
+        {
+          postfix = baseEntry.freePostfixes.back();
+          baseEntry.freePostfixes.pop_back();
+        }
+        else
+          postfix = baseEntry.nextPostfix++;
+
+        proposedName = baseName;
+        proposedName.append("_");
+        proposedName.append(std::to_string(postfix));
+
+        auto empRes = names.emplace(std::move(proposedName), NameEntry{&baseEntry, postfix});
+        inserted = empRes.second;
+        if(inserted)
+          return empRes.first->first.c_str();
+      } while(!inserted); // Only loops in case another base name generated the same string
+
+      return nullptr;
+    }
+
+    void release(const char* name)
+    {
+      if(name)
+        releasedNames.emplace_back(name);
+    }
+
+    void recycleReleased()
+    {
+      for(const std::string& name : releasedNames)
+      {
+        auto it = names.find(name);
+        if(it != names.end())
+        {
+          it->second.baseEntry->freePostfixes.push_back(it->second.postfix);
+          names.erase(it);
+        }
+      }
+      releasedNames.resize(0);
+    }
+
+    bool contains(const char* name) const
+    {
+      return names.find(name) != names.end();
+    }
+
+  protected:
+    struct BaseNameEntry
+    {
+      uint64_t nextPostfix = 0;
+      std::vector<uint64_t> freePostfixes;
+    };
+
+    struct NameEntry
+    {
+      BaseNameEntry* baseEntry; // Node-based map, so pointer is stable
+      uint64_t postfix;
+    };
+
+    std::unordered_map<std::string, BaseNameEntry> baseNames;
+    std::unordered_map<std::string, NameEntry> names;
+    std::vector<std::string> releasedNames;
+};
@@ -5,10 +5,14 @@
 #include "UsdAnari.h"
 #include "UsdDataArray.h"
 #include "UsdDevice.h"
+#include "UsdMeshSimplifier.h"
 #include "UsdBridgeUtils.h"
 #include "anari/frontend/type_utility.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <thread>
 
 DEFINE_PARAMETER_MAP(UsdGeometry,
   REGISTER_PARAMETER_MACRO("name", ANARI_STRING, name)
@@ -17,6 +21,11 @@ DEFINE_PARAMETER_MAP(UsdGeometry,
   REGISTER_PARAMETER_MACRO("usd::timeVarying", ANARI_INT32, timeVarying)
   REGISTER_PARAMETER_MACRO("usd::time.shapeGeometry", ANARI_FLOAT64, shapeGeometryRefTimeStep)
   REGISTER_PARAMETER_MACRO("usd::useUsdGeomPoints", ANARI_BOOL, UseUsdGeomPoints)
+  REGISTER_PARAMETER_MACRO("usd::positionInterval", ANARI_INT32, positionInterval)
+  REGISTER_PARAMETER_MACRO("usd::weldVertices", ANARI_BOOL, weldVertices)
+  REGISTER_PARAMETER_MACRO("usd::weldTolerance", ANARI_FLOAT32, weldTolerance)
+  REGISTER_PARAMETER_MACRO("usd::lod.levels", ANARI_INT32, lodLevels)
+  REGISTER_PARAMETER_MACRO("usd::lod.ratio", ANARI_FLOAT32, lodRatio)
   REGISTER_PARAMETER_MACRO("primitive.index", ANARI_ARRAY, indices)
   REGISTER_PARAMETER_MACRO("primitive.normal", ANARI_ARRAY, primitiveNormals)
   REGISTER_PARAMETER_MACRO("primitive.color", ANARI_ARRAY, primitiveColors)
@@ -31,8 +40,11 @@ DEFINE_PARAMETER_MAP(UsdGeometry,
   REGISTER_PARAMETER_MACRO("vertex.radius", ANARI_ARRAY, vertexRadii)
   REGISTER_PARAMETER_MACRO("vertex.scale", ANARI_ARRAY, vertexScales)
   REGISTER_PARAMETER_MACRO("vertex.orientation", ANARI_ARRAY, vertexOrientations)
+  REGISTER_PARAMETER_MACRO("vertex.velocity", ANARI_ARRAY, vertexVelocities)
+  REGISTER_PARAMETER_MACRO("vertex.angularVelocity", ANARI_ARRAY, vertexAngularVelocities)
   REGISTER_PARAMETER_ARRAY_MACRO("vertex.attribute", "", ANARI_ARRAY, vertexAttributes, MAX_ATTRIBS)
   REGISTER_PARAMETER_ARRAY_MACRO("usd::attribute", ".name", ANARI_STRING, attributeNames, MAX_ATTRIBS)
+  REGISTER_PARAMETER_ARRAY_MACRO("usd::attribute", ".precision", ANARI_STRING, attributePrecisions, MAX_ATTRIBS)
   REGISTER_PARAMETER_MACRO("radius", ANARI_FLOAT32, radiusConstant)
   REGISTER_PARAMETER_MACRO("scale", ANARI_FLOAT32_VEC3, scaleConstant)
   REGISTER_PARAMETER_MACRO("orientation", ANARI_FLOAT32_QUAT_IJKW, orientationConstant)
@@ -61,6 +73,22 @@ struct UsdGeometryTempArrays
   ANARIDataType ColorsArrayType;
   UsdGeometry::AttributeDataArraysType AttributeDataArrays;
 
+  // Vertex welding of meshes, welded vertex arrays are generic byte arrays as well
+  std::vector<char> WeldPointsArray;
+  std::vector<char> WeldNormalsArray;
+  std::vector<char> WeldVelocitiesArray;
+  std::vector<int> WeldIndicesArray;
+  std::vector<double> WeldCells; // Quantized positions
+  std::vector<uint64_t> WeldHashes;
+  std::vector<uint32_t> WeldRemap; // Original vertex to welded vertex
+  std::vector<uint32_t> WeldSources; // Welded vertex to original vertex
+  std::vector<uint32_t> WeldTable;
+
+  // Simplified levels of detail of triangle meshes
+  std::vector<int> LodSourceIndices;
+  std::vector<std::vector<int>> LodIndicesArrays;
+  std::vector<UsdBridgeMeshLod> Lods;
+
   const UsdGeometry::AttributeArray& Attributes;
 
   void resetColorsArray(size_t numElements, ANARIDataType type)
@@ -172,6 +200,25 @@ namespace
     return geomType;
   }
 
+  bool IsValidAttributePrecision(const char* precisionStr)
+  {
+    return strEquals(precisionStr, "native") || strEquals(precisionStr, "half") || strEquals(precisionStr, "normalized8");
+  }
+
+  UsdBridgeAttributePrecision GetAttributePrecision(const UsdSharedString* precision)
+  {
+    const char* precisionStr = UsdSharedString::c_str(precision);
+    if (!precisionStr)
+      return UsdBridgeAttributePrecision::NATIVE;
+
+    if (strEquals(precisionStr, "half"))
+      return UsdBridgeAttributePrecision::HALF;
+    else if (strEquals(precisionStr, "normalized8"))
+      return UsdBridgeAttributePrecision::NORMALIZED8;
+
+    return UsdBridgeAttributePrecision::NATIVE; // Unknown values are reported by filterSetParam()
+  }
+
   uint64_t GetNumberOfPrims(bool hasIndices, const UsdDataLayout& indexLayout, UsdGeometry::GeomType geomType)
   {
     if(geomType == UsdGeometry::GEOM_CURVE)
@@ -210,18 +257,26 @@ namespace
     {
       case ANARI_INT32:
       case ANARI_INT32_VEC2:
+      case ANARI_INT32_VEC3:
+      case ANARI_INT32_VEC4:
         result = (reinterpret_cast<const int*>(indices))[elt];
         break;
       case ANARI_UINT32:
       case ANARI_UINT32_VEC2:
+      case ANARI_UINT32_VEC3:
+      case ANARI_UINT32_VEC4:
         result = (reinterpret_cast<const uint32_t*>(indices))[elt];
         break;
       case ANARI_INT64:
       case ANARI_INT64_VEC2:
+      case ANARI_INT64_VEC3:
+      case ANARI_INT64_VEC4:
         result = (reinterpret_cast<const int64_t*>(indices))[elt];
         break;
       case ANARI_UINT64:
       case ANARI_UINT64_VEC2:
+      case ANARI_UINT64_VEC3:
+      case ANARI_UINT64_VEC4:
         result = (reinterpret_cast<const uint64_t*>(indices))[elt];
         break;
       default:
@@ -685,10 +740,101 @@ namespace
       }
     }
   }
+
+  constexpr size_t weldMinChunkSize = size_t(1) << 14; // Below this amount of elements per thread, a weld pass stays single-threaded
+  constexpr size_t lodMaxLevels = 16; // Upper bound on usd::lod.levels
+  constexpr uint32_t weldInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  // Calls func(begin, end) for contiguous chunks of [0, numElements), each chunk on its own thread
+  template<typename FuncType>
+  void ParallelForChunks(size_t numElements, const FuncType& func)
+  {
+    size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t numThreads = std::min(maxThreads, (numElements + weldMinChunkSize - 1) / weldMinChunkSize);
+    if(numThreads <= 1)
+    {
+      func(size_t(0), numElements);
+      return;
+    }
+
+    size_t chunkSize = (numElements + numThreads - 1) / numThreads;
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads-1);
+    for(size_t threadIdx = 1; threadIdx < numThreads; ++threadIdx)
+    {
+      size_t begin = threadIdx*chunkSize;
+      size_t end = std::min(begin+chunkSize, numElements);
+      if(begin < end)
+        threads.emplace_back([&func, begin, end](){ func(begin, end); });
+    }
+    func(size_t(0), chunkSize);
+
+    for(std::thread& thread : threads)
+      thread.join();
+  }
+
+  struct WeldStream
+  {
+    const char* Data;
+    size_t EltSize;
+    std::vector<char>* Output;
+  };
+
+  // Arrays and strings that make up the content of a geometry for usd::geometryDedup, in a fixed order. Array slots also
+  // distinguish between arrays with the same contents in different parameters, such as vertex and primitive colors.
+  void GetDedupContent(const UsdGeometryData& paramData, std::vector<const UsdDataArray*>& arrays, std::vector<const char*>& strings)
+  {
+    arrays = {
+      paramData.vertexPositions, paramData.vertexNormals, paramData.vertexColors,
+      paramData.primitiveNormals, paramData.primitiveColors, paramData.primitiveIds, paramData.indices,
+      paramData.vertexVelocities, paramData.vertexAngularVelocities,
+      paramData.vertexRadii, paramData.primitiveRadii,
+      paramData.vertexScales, paramData.primitiveScales, paramData.vertexOrientations, paramData.primitiveOrientations
+    };
+    for(int i = 0; i < MAX_ATTRIBS; ++i)
+    {
+      arrays.push_back(paramData.vertexAttributes[i]);
+      arrays.push_back(paramData.primitiveAttributes[i]);
+      strings.push_back(UsdSharedString::c_str(paramData.attributeNames[i]));
+      strings.push_back(UsdSharedString::c_str(paramData.attributePrecisions[i]));
+    }
+  }
+
+  bool EqualDedupArrays(const UsdDataArray* lhs, const UsdDataArray* rhs)
+  {
+    const void* lhsData = lhs ? lhs->getData() : nullptr;
+    const void* rhsData = rhs ? rhs->getData() : nullptr;
+    if(!lhsData || !rhsData)
+      return !lhsData && !rhsData;
+
+    return lhs->getType() == rhs->getType()
+      && memcmp(&lhs->getLayout(), &rhs->getLayout(), sizeof(UsdDataLayout)) == 0
+      && lhs->getDataSizeInBytes() == rhs->getDataSizeInBytes()
+      && (lhsData == rhsData || memcmp(lhsData, rhsData, lhs->getDataSizeInBytes()) == 0);
+  }
+
+  bool EqualDedupStrings(const char* lhs, const char* rhs)
+  {
+    return (lhs && rhs) ? strEquals(lhs, rhs) : (lhs == rhs);
+  }
+
+  void QuantizeWeldPosition(const void* points, bool doublePoints, size_t vertIdx, double invTolerance, double* cell)
+  {
+    for(int comp = 0; comp < 3; ++comp)
+    {
+      double val = doublePoints ?
+        reinterpret_cast<const double*>(points)[vertIdx*3+comp] :
+        static_cast<double>(reinterpret_cast<const float*>(points)[vertIdx*3+comp]);
+      if(invTolerance > 0.0)
+        val = std::floor(val*invTolerance);
+      cell[comp] = val + 0.0; // Turns -0.0 into 0.0, so cells can be compared bytewise
+    }
+  }
 }
 
 UsdGeometry::UsdGeometry(const char* name, const char* type, UsdDevice* device)
   : BridgedBaseObjectType(ANARI_GEOMETRY, name, device)
+  , usdDevice(device)
 {
   bool createTempArrays = false;
 
@@ -706,6 +852,14 @@ UsdGeometry::UsdGeometry(const char* name, const char* type, UsdDevice* device)
 
 UsdGeometry::~UsdGeometry()
 {
+  releaseDedup(usdDevice);
+  usdDevice->removeFromDedupLists(this);
+
+  // Base class destruction of the params does not reach onParamRefChanged of this class anymore
+  UsdGeometry* shapeGeometry = getReadParams().shapeGeometry;
+  if(shapeGeometry)
+    --shapeGeometry->shapeRefCount;
+
 #ifdef OBJECT_LIFETIME_EQUALS_USD_LIFETIME
   if(cachedBridge)
     cachedBridge->DeleteGeometry(usdHandle);
@@ -714,6 +868,8 @@ UsdGeometry::~UsdGeometry()
 
 void UsdGeometry::remove(UsdDevice* device)
 {
+  releaseDedup(device);
+
   applyRemoveFunc(device, &UsdBridge::DeleteGeometry);
 }
 
@@ -731,6 +887,14 @@ void UsdGeometry::filterSetParam(const char *name,
     return;
   }
 
+#ifdef TIME_CLIP_STAGES
+  if(strEquals(name, "usd::positionInterval") && type == ANARI_INT32 && *reinterpret_cast<const int*>(mem) > 1)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' filterSetParam failed: 'usd::positionInterval' is not supported with clip stage output, as USD does not extrapolate positions across clip stages; positions are written every timestep", getName());
+    return;
+  }
+#endif
+
   // In case of an attribute name change, notify observers (such as the surface, to change material/sampler bindings)
   static const char* attribNamePrefix = "usd::attribute";
   if(strcmp(name, attribNamePrefix) > 0)
@@ -739,6 +903,15 @@ void UsdGeometry::filterSetParam(const char *name,
     size_t paramOffset = strlen(name) - strlen(attribNamePostfix);
     if(strcmp(name+paramOffset, attribNamePostfix) == 0)
       hasNewAttribName = true; // Only notify once the commit takes place
+
+    static const char* attribPrecisionPostfix = ".precision";
+    size_t precisionOffset = strlen(name) - strlen(attribPrecisionPostfix);
+    if(strlen(name) > strlen(attribPrecisionPostfix) && strcmp(name+precisionOffset, attribPrecisionPostfix) == 0
+      && type == ANARI_STRING && mem && !IsValidAttributePrecision(reinterpret_cast<const char*>(mem)))
+    {
+      // There is no 16-bit option, as USD has no 16-bit integer array type to store it in
+      device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' has unknown '%s' value '%s' (expected native, half or normalized8), falling back to native precision", getName(), name, reinterpret_cast<const char*>(mem));
+    }
   }
 
   BridgedBaseObjectType::filterSetParam(name, type, mem, device);
@@ -800,6 +973,7 @@ void UsdGeometry::syncAttributeArrays()
         attributeArray[i].PerPrimData = paramData.vertexAttributes[i] ? false : true;
         attributeArray[i].EltSize = static_cast<uint32_t>(anari::sizeOf(attribArray->getType()));
         attributeArray[i].Name = UsdSharedString::c_str(paramData.attributeNames[i]);
+        attributeArray[i].OutputPrecision = GetAttributePrecision(paramData.attributePrecisions[i]);
       }
       else
       {
@@ -833,6 +1007,499 @@ void UsdGeometry::assignTempDataToAttributes(bool perPrimInterpolation)
   }
 }
 
+bool UsdGeometry::evaluatePositionInterval(double dataTimeStep, uint64_t numPoints, bool hasVelocities)
+{
+  const UsdGeometryData& paramData = getReadParams();
+
+#ifdef TIME_CLIP_STAGES
+  // USD treats every clip time as a time sample, so with a clip stage per timestep, positions are never extrapolated
+  // from an earlier timestep and a skipped timestep would leave its clip stage without positions.
+  // Intervals are already rejected by filterSetParam().
+  constexpr bool writesAllPositions = true;
+#else
+  constexpr bool writesAllPositions = false;
+#endif
+
+  // USD extrapolates positions from the last authored positions sample and the velocities at that same time,
+  // so in-between timesteps can skip both. Any change in point count, or a jump back in time, restarts the interval.
+  bool restart = writesAllPositions
+    || !hasVelocities
+    || paramData.positionInterval <= 1
+    || !isTimeVarying(CType::POSITION)
+    || numPoints != positionSampling.numPoints
+    || dataTimeStep < positionSampling.timeStep;
+
+  if(restart)
+  {
+    positionSampling.stepCount = 0;
+    positionSampling.writePositions = true;
+  }
+  else if(dataTimeStep != positionSampling.timeStep) // Recommits of the same timestep keep the earlier decision
+  {
+    ++positionSampling.stepCount;
+    positionSampling.writePositions = (positionSampling.stepCount % paramData.positionInterval) == 0;
+  }
+
+  positionSampling.timeStep = dataTimeStep;
+  positionSampling.numPoints = numPoints;
+
+  return positionSampling.writePositions;
+}
+
+bool UsdGeometry::weldMeshVertices(UsdDevice* device, UsdBridgeMeshData& meshData)
+{
+  typedef UsdBridgeMeshData::DataMemberId DMI;
+  const UsdGeometryData& paramData = getReadParams();
+
+  if(!tempArrays)
+    tempArrays = std::make_unique<UsdGeometryTempArrays>(attributeArray);
+  UsdGeometryTempArrays& temp = *tempArrays;
+  temp.AttributeDataArrays.resize(attributeArray.size());
+
+  // Gather the per-vertex arrays, which are welded along with the positions (the first stream)
+  const UsdDataArray* vertices = paramData.vertexPositions;
+  bool doublePoints = vertices->getType() == ANARI_FLOAT64_VEC3;
+  bool weldNormals = meshData.Normals && !meshData.PerPrimNormals;
+  bool weldColors = meshData.Colors && !meshData.PerPrimColors;
+  bool weldVelocities = meshData.LinearVelocities != nullptr;
+
+  std::vector<WeldStream> streams;
+  streams.push_back({reinterpret_cast<const char*>(meshData.Points), anari::sizeOf(vertices->getType()), &temp.WeldPointsArray});
+
+  DMI weldedMembers = DMI::POINTS | DMI::INDICES;
+  if(weldNormals)
+  {
+    streams.push_back({reinterpret_cast<const char*>(meshData.Normals), anari::sizeOf(paramData.vertexNormals->getType()), &temp.WeldNormalsArray});
+    weldedMembers = weldedMembers | DMI::NORMALS;
+  }
+  if(weldColors)
+  {
+    temp.ColorsArrayType = paramData.vertexColors->getType();
+    streams.push_back({reinterpret_cast<const char*>(meshData.Colors), anari::sizeOf(temp.ColorsArrayType), &temp.ColorsArray});
+    weldedMembers = weldedMembers | DMI::COLORS;
+  }
+  if(weldVelocities)
+  {
+    streams.push_back({reinterpret_cast<const char*>(meshData.LinearVelocities), sizeof(float)*3, &temp.WeldVelocitiesArray});
+    weldedMembers = weldedMembers | DMI::LINEARVELOCITIES;
+  }
+  for(size_t attribIdx = 0; attribIdx < attributeArray.size(); ++attribIdx)
+  {
+    const UsdBridgeAttribute& attrib = attributeArray[attribIdx];
+    if(attrib.Data && !attrib.PerPrimData)
+    {
+      streams.push_back({reinterpret_cast<const char*>(attrib.Data), attrib.EltSize, &temp.AttributeDataArrays[attribIdx]});
+      weldedMembers = weldedMembers | ubutils::GetAttribBit<DMI>(static_cast<int>(attribIdx));
+    }
+  }
+
+  // The welded topology depends on all welded arrays, so they are either all timevarying or none of them are.
+  // Done regardless of the outcome below, to keep the timevarying state consistent over timesteps.
+  if((meshData.TimeVarying & weldedMembers) != DMI::NONE)
+    meshData.TimeVarying = meshData.TimeVarying | weldedMembers;
+
+  uint64_t numPoints = meshData.NumPoints;
+  uint64_t numIndices = meshData.NumIndices;
+  if(numPoints == 0 || numPoints >= static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  // Only vertices referenced by the indices survive compaction (remap entry is set to 0 until welded)
+  const UsdDataArray* indices = paramData.indices;
+  const void* indexData = indices ? indices->getData() : nullptr;
+  ANARIDataType indexType = indices ? indices->getType() : ANARI_UNKNOWN;
+
+  std::vector<uint32_t>& remap = temp.WeldRemap;
+  if(indices)
+  {
+    remap.assign(numPoints, weldInvalidIndex);
+    for(uint64_t i = 0; i < numIndices; ++i)
+    {
+      size_t vertIdx = getIndex(indexData, indexType, i);
+      if(vertIdx >= numPoints)
+      {
+        device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT,
+          "UsdGeometry '%s' vertex welding skipped: 'primitive.index' refers to vertices beyond the size of 'vertex.position'", getName());
+        return false;
+      }
+      remap[vertIdx] = 0;
+    }
+  }
+  else
+    remap.assign(numPoints, 0);
+
+  // Quantize and hash the vertices in parallel
+  double invTolerance = paramData.weldTolerance > 0.0f ? 1.0 / static_cast<double>(paramData.weldTolerance) : 0.0;
+
+  std::vector<double>& cells = temp.WeldCells;
+  std::vector<uint64_t>& hashes = temp.WeldHashes;
+  cells.resize(numPoints*3);
+  hashes.resize(numPoints);
+
+  ParallelForChunks(numPoints, [&](size_t begin, size_t end)
+  {
+    for(size_t vertIdx = begin; vertIdx < end; ++vertIdx)
+    {
+      if(remap[vertIdx] == weldInvalidIndex)
+        continue;
+
+      double* cell = &cells[vertIdx*3];
+      QuantizeWeldPosition(meshData.Points, doublePoints, vertIdx, invTolerance, cell);
+
+      uint64_t hash = ubutils::HashBytes(cell, sizeof(double)*3);
+      for(size_t streamIdx = 1; streamIdx < streams.size(); ++streamIdx)
+      {
+        const WeldStream& stream = streams[streamIdx];
+        hash = ubutils::HashBytes(stream.Data + vertIdx*stream.EltSize, stream.EltSize, hash);
+      }
+      hashes[vertIdx] = hash;
+    }
+  });
+
+  auto verticesEqual = [&cells, &streams](size_t vertA, size_t vertB)
+  {
+    if(memcmp(&cells[vertA*3], &cells[vertB*3], sizeof(double)*3) != 0)
+      return false;
+    for(size_t streamIdx = 1; streamIdx < streams.size(); ++streamIdx)
+    {
+      const WeldStream& stream = streams[streamIdx];
+      if(memcmp(stream.Data + vertA*stream.EltSize, stream.Data + vertB*stream.EltSize, stream.EltSize) != 0)
+        return false;
+    }
+    return true;
+  };
+
+  // Assign welded indices in order of first occurrence, using an open addressing table of representative vertices
+  size_t tableSize = 1;
+  while(tableSize < numPoints*2)
+    tableSize <<= 1;
+  size_t tableMask = tableSize-1;
+
+  std::vector<uint32_t>& table = temp.WeldTable;
+  std::vector<uint32_t>& sources = temp.WeldSources;
+  table.assign(tableSize, weldInvalidIndex);
+  sources.resize(0);
+
+  for(size_t vertIdx = 0; vertIdx < numPoints; ++vertIdx)
+  {
+    if(remap[vertIdx] == weldInvalidIndex)
+      continue;
+
+    uint64_t hash = hashes[vertIdx];
+    size_t slot = (hash ^ (hash >> 32)) & tableMask;
+    while(table[slot] != weldInvalidIndex && (hashes[table[slot]] != hash || !verticesEqual(table[slot], vertIdx)))
+      slot = (slot+1) & tableMask;
+
+    if(table[slot] == weldInvalidIndex)
+    {
+      table[slot] = static_cast<uint32_t>(vertIdx);
+      remap[vertIdx] = static_cast<uint32_t>(sources.size());
+      sources.push_back(static_cast<uint32_t>(vertIdx));
+    }
+    else
+      remap[vertIdx] = remap[table[slot]];
+  }
+
+  uint64_t numWelded = sources.size();
+  if(numWelded == numPoints)
+    return false; // All vertices unique and referenced, so the remapping is the identity
+
+  // Compact the vertex arrays and remap the indices
+  for(const WeldStream& stream : streams)
+    stream.Output->resize(numWelded*stream.EltSize);
+
+  ParallelForChunks(numWelded, [&](size_t begin, size_t end)
+  {
+    for(const WeldStream& stream : streams)
+    {
+      for(size_t weldIdx = begin; weldIdx < end; ++weldIdx)
+        memcpy(stream.Output->data() + weldIdx*stream.EltSize, stream.Data + sources[weldIdx]*stream.EltSize, stream.EltSize);
+    }
+  });
+
+  std::vector<int>& weldIndices = temp.WeldIndicesArray;
+  weldIndices.resize(numIndices);
+
+  ParallelForChunks(numIndices, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      size_t vertIdx = indexData ? getIndex(indexData, indexType, i) : i;
+      weldIndices[i] = static_cast<int>(remap[vertIdx]);
+    }
+  });
+
+  meshData.NumPoints = numWelded;
+  meshData.Points = temp.WeldPointsArray.data();
+  if(weldNormals)
+    meshData.Normals = temp.WeldNormalsArray.data();
+  if(weldColors)
+    meshData.Colors = temp.ColorsArray.data();
+  if(weldVelocities)
+    meshData.LinearVelocities = reinterpret_cast<const float*>(temp.WeldVelocitiesArray.data());
+  for(size_t attribIdx = 0; attribIdx < attributeArray.size(); ++attribIdx)
+  {
+    if(attributeArray[attribIdx].Data && !attributeArray[attribIdx].PerPrimData)
+      attributeArray[attribIdx].Data = temp.AttributeDataArrays[attribIdx].data();
+  }
+
+  meshData.Indices = weldIndices.data();
+  meshData.IndicesType = UsdBridgeType::INT;
+
+  return true;
+}
+
+void UsdGeometry::generateMeshLods(UsdDevice* device, UsdBridgeMeshData& meshData)
+{
+  const UsdGeometryData& paramData = getReadParams();
+  const char* debugName = getName();
+
+  if(paramData.lodRatio <= 0.0f || paramData.lodRatio >= 1.0f)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT,
+      "UsdGeometry '%s' levels of detail skipped: 'usd::lod.ratio' should lie between 0 and 1 (exclusive)", debugName);
+    return;
+  }
+
+  // With 'usd::timeVarying.index' set, the levels are generated from the current topology; the bridge only keeps them for as long as that topology stays unchanged
+
+  // The levels only replace the topology, so per-face data of the full mesh would no longer match up
+  bool hasPerPrimData = (meshData.Normals && meshData.PerPrimNormals) || (meshData.Colors && meshData.PerPrimColors);
+  for(size_t attribIdx = 0; attribIdx < attributeArray.size(); ++attribIdx)
+    hasPerPrimData = hasPerPrimData || (attributeArray[attribIdx].Data && attributeArray[attribIdx].PerPrimData);
+  if(hasPerPrimData)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT,
+      "UsdGeometry '%s' levels of detail skipped: not supported in combination with 'primitive.X' arrays", debugName);
+    return;
+  }
+
+  if(!tempArrays)
+    tempArrays = std::make_unique<UsdGeometryTempArrays>(attributeArray);
+  UsdGeometryTempArrays& temp = *tempArrays;
+
+  // The simplifier takes int indices, which welded indices already are
+  const int* srcIndices = nullptr;
+  if(meshData.Indices && meshData.IndicesType == UsdBridgeType::INT)
+    srcIndices = reinterpret_cast<const int*>(meshData.Indices);
+  else
+  {
+    const UsdDataArray* indices = paramData.indices;
+    temp.LodSourceIndices.resize(meshData.NumIndices);
+    for(uint64_t i = 0; i < meshData.NumIndices; ++i)
+      temp.LodSourceIndices[i] = static_cast<int>(indices ? getIndex(indices->getData(), indices->getType(), i) : i);
+    srcIndices = temp.LodSourceIndices.data();
+  }
+
+  bool doublePoints = paramData.vertexPositions->getType() == ANARI_FLOAT64_VEC3;
+  UsdMeshSimplifier simplifier(meshData.Points, doublePoints, meshData.NumPoints, srcIndices, meshData.NumIndices);
+
+  // Levels beyond the one that reaches a single triangle would all be equal
+  uint64_t numTriangles = meshData.NumIndices / 3;
+  size_t numLevels = 0;
+  for(double targetNumTriangles = numTriangles * paramData.lodRatio;
+    numLevels < static_cast<size_t>(paramData.lodLevels) && numLevels < lodMaxLevels && targetNumTriangles >= 1.0;
+    targetNumTriangles *= paramData.lodRatio)
+    ++numLevels;
+  if(numLevels < static_cast<size_t>(paramData.lodLevels))
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_WARNING, ANARI_STATUS_INVALID_ARGUMENT,
+      "UsdGeometry '%s' levels of detail limited to %i: further levels would have less than one triangle or exceed the maximum of %i levels",
+      debugName, static_cast<int>(numLevels), static_cast<int>(lodMaxLevels));
+  }
+  if(numLevels == 0)
+    return;
+
+  // Every level is simplified from the full mesh, spread over at most as many threads as the hardware supports
+  temp.LodIndicesArrays.resize(numLevels);
+
+  auto simplifyLevel = [&simplifier, &temp, numTriangles, &paramData](size_t levelIdx)
+  {
+    size_t targetNumTriangles = static_cast<size_t>(numTriangles * std::pow(static_cast<double>(paramData.lodRatio), static_cast<double>(levelIdx+1)));
+    simplifier.simplify(targetNumTriangles, temp.LodIndicesArrays[levelIdx]);
+  };
+
+  size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t numThreads = std::min(maxThreads, numLevels);
+  auto simplifyLevels = [&simplifyLevel, numThreads, numLevels](size_t threadIdx)
+  {
+    for(size_t levelIdx = threadIdx; levelIdx < numLevels; levelIdx += numThreads)
+      simplifyLevel(levelIdx);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads-1);
+  for(size_t threadIdx = 1; threadIdx < numThreads; ++threadIdx)
+    threads.emplace_back(simplifyLevels, threadIdx);
+  simplifyLevels(0);
+
+  for(std::thread& thread : threads)
+    thread.join();
+
+  temp.Lods.resize(numLevels);
+  for(size_t levelIdx = 0; levelIdx < numLevels; ++levelIdx)
+  {
+    temp.Lods[levelIdx].Indices = temp.LodIndicesArrays[levelIdx].data();
+    temp.Lods[levelIdx].NumIndices = temp.LodIndicesArrays[levelIdx].size();
+  }
+
+  meshData.Lods = temp.Lods.data();
+  meshData.NumLods = static_cast<uint32_t>(numLevels);
+}
+
+bool UsdGeometry::isDedupCandidate(UsdDevice* device) const
+{
+  const UsdGeometryData& paramData = getReadParams();
+
+  // Only data that is uniform over all timesteps can be shared. Glyphs carry prototype refs,
+  // and glyph shapes are referenced by the prim of the shape geometry itself.
+  static constexpr int componentMask = (1 << (static_cast<int>(UsdGeometryComponents::ANGULARVELOCITY) + 1)) - 1;
+  return device->getReadParams().geometryDedup
+    && geomType != GEOM_GLYPH
+    && shapeRefCount == 0
+    && (paramData.timeVarying & componentMask) == 0;
+}
+
+uint64_t UsdGeometry::computeContentHash() const
+{
+  const UsdGeometryData& paramData = getReadParams();
+
+  uint64_t hash = ubutils::HashBytes(&geomType, sizeof(geomType));
+  hash = ubutils::HashBytes(&paramData.UseUsdGeomPoints, sizeof(paramData.UseUsdGeomPoints), hash);
+  hash = ubutils::HashBytes(&paramData.radiusConstant, sizeof(paramData.radiusConstant), hash);
+  hash = ubutils::HashBytes(&paramData.scaleConstant, sizeof(paramData.scaleConstant), hash);
+  hash = ubutils::HashBytes(&paramData.orientationConstant, sizeof(paramData.orientationConstant), hash);
+  hash = ubutils::HashBytes(&paramData.weldVertices, sizeof(paramData.weldVertices), hash);
+  hash = ubutils::HashBytes(&paramData.weldTolerance, sizeof(paramData.weldTolerance), hash);
+  hash = ubutils::HashBytes(&paramData.lodLevels, sizeof(paramData.lodLevels), hash);
+  hash = ubutils::HashBytes(&paramData.lodRatio, sizeof(paramData.lodRatio), hash);
+
+  std::vector<const UsdDataArray*> arrays;
+  std::vector<const char*> strings;
+  GetDedupContent(paramData, arrays, strings);
+
+  for(uint64_t slot = 0; slot < arrays.size(); ++slot)
+  {
+    const UsdDataArray* array = arrays[slot];
+    hash = ubutils::HashBytes(&slot, sizeof(slot), hash);
+    if(array && array->getData())
+    {
+      ANARIDataType arrayType = array->getType();
+      hash = ubutils::HashBytes(&arrayType, sizeof(arrayType), hash);
+      hash = ubutils::HashBytes(&array->getLayout(), sizeof(UsdDataLayout), hash);
+      hash = ubutils::HashBytes(array->getData(), array->getDataSizeInBytes(), hash);
+    }
+  }
+  for(const char* chars : strings)
+    hash = ubutils::HashBytes(chars, chars ? strlen(chars)+1 : 0, hash);
+
+  return hash;
+}
+
+bool UsdGeometry::hasEqualContent(const UsdGeometry* other) const
+{
+  const UsdGeometryData& paramData = getReadParams();
+  const UsdGeometryData& otherData = other->getReadParams();
+
+  auto equalBytes = [](const auto& lhs, const auto& rhs) { return memcmp(&lhs, &rhs, sizeof(lhs)) == 0; };
+  if(geomType != other->geomType
+    || !equalBytes(paramData.UseUsdGeomPoints, otherData.UseUsdGeomPoints)
+    || !equalBytes(paramData.radiusConstant, otherData.radiusConstant)
+    || !equalBytes(paramData.scaleConstant, otherData.scaleConstant)
+    || !equalBytes(paramData.orientationConstant, otherData.orientationConstant)
+    || !equalBytes(paramData.weldVertices, otherData.weldVertices)
+    || !equalBytes(paramData.weldTolerance, otherData.weldTolerance)
+    || !equalBytes(paramData.lodLevels, otherData.lodLevels)
+    || !equalBytes(paramData.lodRatio, otherData.lodRatio))
+    return false;
+
+  std::vector<const UsdDataArray*> arrays, otherArrays;
+  std::vector<const char*> strings, otherStrings;
+  GetDedupContent(paramData, arrays, strings);
+  GetDedupContent(otherData, otherArrays, otherStrings);
+
+  for(size_t i = 0; i < arrays.size(); ++i)
+  {
+    if(!EqualDedupArrays(arrays[i], otherArrays[i]))
+      return false;
+  }
+  for(size_t i = 0; i < strings.size(); ++i)
+  {
+    if(!EqualDedupStrings(strings[i], otherStrings[i]))
+      return false;
+  }
+  return true;
+}
+
+bool UsdGeometry::updateDedup(UsdDevice* device)
+{
+  bool candidate = isDedupCandidate(device);
+  uint64_t contentHash = candidate ? computeContentHash() : 0;
+
+  if(dedupRegistered && candidate && contentHash == dedupHash)
+    return isDeduplicated(); // Contents unchanged, keep the current source (or duplicates)
+
+  UsdGeometry* prevSource = dedupSource;
+  releaseDedup(device);
+
+  if(candidate)
+  {
+    UsdGeometry* source = device->acquireDedupGeometry(contentHash, this);
+    if(source) // Otherwise the hash collides with a geometry of different content, so the data is written to this geometry's own prim
+    {
+      dedupHash = contentHash;
+      dedupRegistered = true;
+      dedupSource = (source != this) ? source : nullptr;
+    }
+  }
+
+  if(dedupSource != prevSource)
+    device->markDedupChanged(this);
+
+  return isDeduplicated();
+}
+
+void UsdGeometry::releaseDedup(UsdDevice* device)
+{
+  if(dedupRegistered)
+  {
+    device->releaseDedupGeometry(dedupHash, this);
+    dedupRegistered = false;
+  }
+  dedupSource = nullptr;
+}
+
+void UsdGeometry::onDedupSourceReleased(UsdDevice* device)
+{
+  dedupSource = nullptr;
+  dedupRegistered = false;
+  device->markDedupChanged(this);
+}
+
+void UsdGeometry::commitDedupOrphan(UsdDevice* device)
+{
+  // Contents are unchanged, but either another source has to be found or the data has to be written to this geometry's own prim
+  paramChanged = true;
+  doCommitData(device);
+}
+
+void UsdGeometry::onParamRefChanged(UsdBaseObject* paramObject, bool incRef, bool onWriteParams)
+{
+  if(!onWriteParams && paramObject->getType() == ANARI_GEOMETRY) // shapeGeometry
+  {
+    UsdGeometry* shapeGeometry = static_cast<UsdGeometry*>(paramObject);
+    shapeGeometry->shapeRefCount += incRef ? 1 : -1;
+
+    // A deduplicated geometry has no data on its own prim, so it has to be written before it can be used as shape
+    if(incRef && shapeGeometry->isDeduplicated() && !usdDevice->isFlushingCommitList())
+    {
+      shapeGeometry->paramChanged = true;
+      usdDevice->addToCommitList(shapeGeometry, true);
+    }
+  }
+
+  BridgedBaseObjectType::onParamRefChanged(paramObject, incRef, onWriteParams);
+}
+
 void UsdGeometry::initializeGeomData(UsdBridgeMeshData& geomData)
 {
   typedef UsdBridgeMeshData::DataMemberId DMI;
@@ -842,7 +1509,8 @@ void UsdGeometry::initializeGeomData(UsdBridgeMeshData& geomData)
     & (isTimeVarying(CType::POSITION) ? DMI::ALL : ~DMI::POINTS)
     & (isTimeVarying(CType::NORMAL) ? DMI::ALL : ~DMI::NORMALS)
     & (isTimeVarying(CType::COLOR) ? DMI::ALL : ~DMI::COLORS)
-    & (isTimeVarying(CType::INDEX) ? DMI::ALL : ~DMI::INDICES);
+    & (isTimeVarying(CType::INDEX) ? DMI::ALL : ~DMI::INDICES)
+    & (isTimeVarying(CType::VELOCITY) ? DMI::ALL : ~DMI::LINEARVELOCITIES);
   setAttributeTimeVarying<UsdBridgeMeshData>(geomData.TimeVarying);
 
   geomData.FaceVertexCount = geomType == GEOM_QUAD ? 4 : 3;
@@ -863,6 +1531,8 @@ void UsdGeometry::initializeGeomData(UsdBridgeInstancerData& geomData)
     & (isTimeVarying(CType::INDEX) ? DMI::ALL : ~DMI::INVISIBLEIDS)
     & (isTimeVarying(CType::COLOR) ? DMI::ALL : ~DMI::COLORS)
     & (isTimeVarying(CType::ID) ? DMI::ALL : ~DMI::INSTANCEIDS)
+    & (isTimeVarying(CType::VELOCITY) ? DMI::ALL : ~DMI::LINEARVELOCITIES)
+    & (isTimeVarying(CType::ANGULARVELOCITY) ? DMI::ALL : ~DMI::ANGULARVELOCITIES)
     & ~DMI::SHAPEINDICES; // Shapeindices are always the same, and USD clients typically do not support timevarying shapes
   setAttributeTimeVarying<UsdBridgeInstancerData>(geomData.TimeVarying);
 
@@ -978,6 +1648,8 @@ bool UsdGeometry::checkGeomParams(UsdDevice* device)
   success = success && checkArrayConstraints(paramData.vertexScales, paramData.primitiveScales, "vertex/primitive.scale", device, debugName);
   success = success && checkArrayConstraints(paramData.vertexOrientations, paramData.primitiveOrientations, "vertex/primitive.orientation", device, debugName);
   success = success && checkArrayConstraints(nullptr, paramData.primitiveIds, "primitive.id", device, debugName);
+  success = success && checkArrayConstraints(paramData.vertexVelocities, nullptr, "vertex.velocity", device, debugName);
+  success = success && checkArrayConstraints(paramData.vertexAngularVelocities, nullptr, "vertex.angularVelocity", device, debugName);
 
   if (!success)
     return false;
@@ -1107,6 +1779,18 @@ bool UsdGeometry::checkGeomParams(UsdDevice* device)
     }
   }
 
+  if (paramData.vertexVelocities && paramData.vertexVelocities->getType() != ANARI_FLOAT32_VEC3)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' commit failed: 'vertex.velocity' parameter should be of type ANARI_FLOAT32_VEC3.", debugName);
+    return false;
+  }
+
+  if (paramData.vertexAngularVelocities && paramData.vertexAngularVelocities->getType() != ANARI_FLOAT32_VEC3)
+  {
+    device->reportStatus(this, ANARI_GEOMETRY, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT, "UsdGeometry '%s' commit failed: 'vertex.angularVelocity' parameter should be of type ANARI_FLOAT32_VEC3.", debugName);
+    return false;
+  }
+
   return true;
 }
 
@@ -1133,6 +1817,11 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridge* usdBridge, UsdBri
     meshData.ColorsType = AnariToUsdBridgeType(colors->getType());
     meshData.PerPrimColors = paramData.vertexColors ? false : true;
   }
+  const UsdDataArray* velocities = paramData.vertexVelocities;
+  if (velocities)
+  {
+    meshData.LinearVelocities = reinterpret_cast<const float*>(velocities->getData());
+  }
 
   const UsdDataArray* indices = paramData.indices;
   if (indices)
@@ -1149,10 +1838,26 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridge* usdBridge, UsdBri
     meshData.IndicesType = UsdBridgeType::INT;
   }
 
+  // Welding rewrites the indices along with all per-vertex arrays, so positions cannot be skipped by the position interval
+  if(paramData.weldVertices)
+    weldMeshVertices(device, meshData);
+
+  if(geomType == GEOM_TRIANGLE && paramData.lodLevels > 0)
+    generateMeshLods(device, meshData);
+
   //meshData.UpdatesToPerform = Still to be implemented
 
   double worldTimeStep = device->getReadParams().timeStep;
   double dataTimeStep = selectObjTime(paramData.timeStep, worldTimeStep);
+
+  // With usd::timeSampleSharing, the changed vertices are compared and split off per timestep, which requires their positions
+  bool positionIntervalApplies = velocities != nullptr && !paramData.weldVertices && !device->getReadParams().timeSampleSharing;
+  if(!evaluatePositionInterval(dataTimeStep, meshData.NumPoints, positionIntervalApplies))
+  {
+    typedef UsdBridgeMeshData::DataMemberId DMI;
+    meshData.UpdatesToPerform = DMI::ALL & ~DMI::POINTS & ~DMI::LINEARVELOCITIES;
+  }
+
   usdBridge->SetGeometryData(usdHandle, meshData, dataTimeStep);
 }
 
@@ -1266,6 +1971,13 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridge* usdBridge, UsdBri
       instancerData.Scale.Data[i] = (geomType == GEOM_SPHERE) ? paramData.radiusConstant : paramData.scaleConstant.Data[i];
 
     instancerData.Orientation = paramData.orientationConstant;
+
+    // Velocities
+    // map one-to-one onto the vertices, which stay intact for indexed spheres (see above)
+    if (paramData.vertexVelocities)
+      instancerData.LinearVelocities = reinterpret_cast<const float*>(paramData.vertexVelocities->getData());
+    if (paramData.vertexAngularVelocities)
+      instancerData.AngularVelocities = reinterpret_cast<const float*>(paramData.vertexAngularVelocities->getData());
   }
   else
   {
@@ -1307,6 +2019,14 @@ void UsdGeometry::updateGeomData(UsdDevice* device, UsdBridge* usdBridge, UsdBri
 
   double worldTimeStep = device->getReadParams().timeStep;
   double dataTimeStep = selectObjTime(paramData.timeStep, worldTimeStep);
+
+  if(!evaluatePositionInterval(dataTimeStep, instancerData.NumPoints, instancerData.LinearVelocities != nullptr))
+  {
+    // Angular velocities relate to the orientations, which are still written every timestep
+    typedef UsdBridgeInstancerData::DataMemberId DMI;
+    instancerData.UpdatesToPerform = DMI::ALL & ~DMI::POINTS & ~DMI::LINEARVELOCITIES;
+  }
+
   usdBridge->SetGeometryData(usdHandle, instancerData, dataTimeStep);
 
   if(isNew && geomType != GEOM_GLYPH && !instancerData.UseUsdGeomPoints)
@@ -1383,7 +2103,16 @@ bool UsdGeometry::commitTemplate(UsdDevice* device)
     if (paramData.vertexPositions)
     {
       if(checkGeomParams(device))
-        updateGeomData(device, usdBridge, geomData, isNew);
+      {
+        // Data identical to that of another geometry is not written, surfaces reference the prim of the source instead
+        if(updateDedup(device))
+          dedupSkippedNew = dedupSkippedNew || isNew;
+        else
+        {
+          updateGeomData(device, usdBridge, geomData, isNew || dedupSkippedNew);
+          dedupSkippedNew = false;
+        }
+      }
     }
     else
     {
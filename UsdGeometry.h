@@ -37,7 +37,9 @@ enum class UsdGeometryComponents
   ATTRIBUTE12,
   ATTRIBUTE13,
   ATTRIBUTE14,
-  ATTRIBUTE15
+  ATTRIBUTE15,
+  VELOCITY,
+  ANGULARVELOCITY
 };
 
 struct UsdGeometryData
@@ -57,7 +59,21 @@ struct UsdGeometryData
   const UsdDataArray* primitiveAttributes[MAX_ATTRIBS] = { nullptr };
   const UsdDataArray* primitiveIds = nullptr;
   const UsdSharedString* attributeNames[MAX_ATTRIBS] = { nullptr };
+  const UsdSharedString* attributePrecisions[MAX_ATTRIBS] = { nullptr };
   const UsdDataArray* indices = nullptr; 
+
+  // Motion
+  const UsdDataArray* vertexVelocities = nullptr;
+  const UsdDataArray* vertexAngularVelocities = nullptr;
+  int positionInterval = 1; // With velocities present, positions are only written every positionInterval timesteps
+
+  // Triangles/quads
+  bool weldVertices = false; // Merge duplicate vertices and drop unreferenced ones before output
+  float weldTolerance = 0.0f; // Grid cell size within which positions are considered equal (0 is exact)
+
+  // Triangles
+  int lodLevels = 0; // Number of simplified levels of detail written besides the full mesh
+  float lodRatio = 0.5f; // Triangle count of each level relative to the level before
   
   // Spheres
   const UsdDataArray* vertexRadii = nullptr;
@@ -133,6 +149,15 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
 
     bool getHasNewAttribName() const { return hasNewAttribName; }
 
+    // Geometry of which the prim holds the committed data, which differs from this one if deduplicated (usd::geometryDedup)
+    UsdGeometry* getDedupSource() { return dedupSource ? dedupSource : this; }
+    bool isDeduplicated() const { return dedupSource != nullptr; }
+
+    bool hasEqualContent(const UsdGeometry* other) const; // Compares the data hashed by computeContentHash()
+    void releaseDedup(UsdDevice* device);
+    void onDedupSourceReleased(UsdDevice* device);
+    void commitDedupOrphan(UsdDevice* device);
+
     static constexpr ComponentPair componentParamNames[] = {
       ComponentPair(UsdGeometryComponents::POSITION, "position"),
       ComponentPair(UsdGeometryComponents::NORMAL, "normal"),
@@ -157,13 +182,17 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
       ComponentPair(UsdGeometryComponents::ATTRIBUTE12, "attribute12"),
       ComponentPair(UsdGeometryComponents::ATTRIBUTE13, "attribute13"),
       ComponentPair(UsdGeometryComponents::ATTRIBUTE14, "attribute14"),
-      ComponentPair(UsdGeometryComponents::ATTRIBUTE15, "attribute15")};
+      ComponentPair(UsdGeometryComponents::ATTRIBUTE15, "attribute15"),
+      ComponentPair(UsdGeometryComponents::VELOCITY, "velocity"),
+      ComponentPair(UsdGeometryComponents::ANGULARVELOCITY, "angularVelocity")};
 
   protected:
     bool deferCommit(UsdDevice* device) override;
     bool doCommitData(UsdDevice* device) override;
     void doCommitRefs(UsdDevice* device) override;
 
+    void onParamRefChanged(UsdBaseObject* paramObject, bool incRef, bool onWriteParams) override;
+
     void initializeGeomData(UsdBridgeMeshData& geomData);
     void initializeGeomData(UsdBridgeInstancerData& geomData);
     void initializeGeomData(UsdBridgeCurveData& geomData);
@@ -193,6 +222,15 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
 
     void assignTempDataToAttributes(bool perPrimInterpolation);
 
+    bool evaluatePositionInterval(double dataTimeStep, uint64_t numPoints, bool hasVelocities);
+
+    bool weldMeshVertices(UsdDevice* device, UsdBridgeMeshData& meshData); // Returns whether meshData points to welded arrays
+    void generateMeshLods(UsdDevice* device, UsdBridgeMeshData& meshData);
+
+    bool isDedupCandidate(UsdDevice* device) const;
+    uint64_t computeContentHash() const;
+    bool updateDedup(UsdDevice* device); // Returns whether the data is authored by another geometry
+
     GeomType geomType = GEOM_UNKNOWN;
     bool protoShapeChanged = false; // Do not automatically commit shapes (the object may have been recreated onto an already existing USD prim)
 
@@ -201,4 +239,19 @@ class UsdGeometry : public UsdBridgedBaseObject<UsdGeometry, UsdGeometryData, Us
     std::unique_ptr<UsdGeometryTempArrays> tempArrays;
 
     AttributeArray attributeArray;
+
+    struct PositionSampling
+    {
+      double timeStep = std::numeric_limits<double>::quiet_NaN();
+      uint64_t numPoints = 0;
+      uint64_t stepCount = 0; // Timesteps since positions were last (re)started
+      bool writePositions = true;
+    } positionSampling;
+
+    UsdDevice* usdDevice = nullptr;
+    UsdGeometry* dedupSource = nullptr;
+    uint64_t dedupHash = 0;
+    bool dedupRegistered = false;
+    bool dedupSkippedNew = false; // Initialization on first data write still has to happen
+    int shapeRefCount = 0; // Number of glyph geometries using this one as shape, which reference its own prim
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "UsdAnari.h"
 #include "UsdDevice.h"
 #include "UsdGroup.h"
+#include "UsdDataArray.h"
 
 #define GroupType ANARI_GROUP
 using GroupUsdType = AnariToUsdBridgedObject<GroupType>::Type;
@@ -14,7 +15,7 @@ DEFINE_PARAMETER_MAP(UsdInstance,
   REGISTER_PARAMETER_MACRO("usd::name", ANARI_STRING, usdName)
   REGISTER_PARAMETER_MACRO("usd::timeVarying", ANARI_INT32, timeVarying)
   REGISTER_PARAMETER_MACRO("group", GroupType, group)
-  REGISTER_PARAMETER_MACRO("transform", ANARI_FLOAT32_MAT4, transform)
+  REGISTER_PARAMETER_MULTITYPE_MACRO("transform", ANARI_FLOAT32_MAT4, ANARI_ARRAY, UsdUnusedParamType, transform)
 )
 
 constexpr UsdInstance::ComponentPair UsdInstance::componentParamNames[]; // Workaround for C++14's lack of inlining constexpr arrays
@@ -33,6 +34,15 @@ UsdInstance::~UsdInstance()
 #endif
 }
 
+void UsdInstance::commit(UsdDevice* device)
+{
+  BridgedBaseObjectType::commit(device);
+
+  // Batched instances are written by the worlds referencing them
+  if(device->getReadParams().instanceBatching)
+    notify(this, device);
+}
+
 void UsdInstance::remove(UsdDevice* device)
 {
   applyRemoveFunc(device, &UsdBridge::DeleteInstance);
@@ -43,6 +53,27 @@ bool UsdInstance::isInstanceable() const
   return false;
 }
 
+const UsdFloatMat4* UsdInstance::getTransforms(uint64_t& numTransforms) const
+{
+  const UsdInstanceData& paramData = getReadParams();
+
+  UsdDataArray* transformArray = nullptr;
+  if(paramData.transform.Get(transformArray))
+  {
+    const UsdDataLayout& layout = transformArray->getLayout();
+    if(transformArray->getType() != ANARI_FLOAT32_MAT4 || !layout.isDense() || !layout.isOneDimensional())
+    {
+      numTransforms = 0;
+      return nullptr;
+    }
+    numTransforms = layout.numItems1;
+    return reinterpret_cast<const UsdFloatMat4*>(transformArray->getData());
+  }
+
+  numTransforms = 1;
+  return &paramData.transform.data.type0;
+}
+
 bool UsdInstance::deferCommit(UsdDevice* device)
 {
   const UsdInstanceData& paramData = getReadParams();
@@ -56,6 +87,17 @@ bool UsdInstance::deferCommit(UsdDevice* device)
 
 bool UsdInstance::doCommitData(UsdDevice* device)
 {
+  if(device->getReadParams().instanceBatching)
+  {
+    // No prim of its own; group and transform end up in a point instancer of the world
+    UsdDataArray* transformArray = nullptr;
+    if(getReadParams().transform.Get(transformArray))
+      assertTransformArray(transformArray, device);
+
+    paramChanged = false;
+    return false;
+  }
+
   UsdBridge* usdBridge = device->getUsdBridge();
 
   const char* instanceName = getName();
@@ -84,6 +126,41 @@ void UsdInstance::doCommitRefs(UsdDevice* device)
   bool groupTimeVarying = isTimeVarying(UsdInstanceComponents::GROUP);
   bool transformTimeVarying = isTimeVarying(UsdInstanceComponents::TRANSFORM);
 
+  UsdDataArray* transformArray = nullptr;
+  if(paramData.transform.Get(transformArray))
+  {
+    if(!assertTransformArray(transformArray, device))
+      return;
+
+    // Multiple placements of the group are written as a point instancer below the instance prim
+    if(!transformArrayWritten)
+      usdBridge->DeleteGroupRef(usdHandle, groupTimeVarying, timeStep);
+    transformArrayWritten = true;
+
+    if (paramData.group)
+    {
+      UsdBridgeInstanceBatch batch;
+      batch.Group = paramData.group->getUsdHandle();
+      batch.Transforms = reinterpret_cast<const float*>(transformArray->getData());
+      batch.NumTransforms = transformArray->getLayout().numItems1;
+      batch.TimeVarying = transformTimeVarying;
+
+      usdBridge->SetInstanceBatches(usdHandle, &batch, 1, transformTimeVarying, timeStep);
+    }
+    else
+    {
+      usdBridge->DeleteInstanceBatches(usdHandle, transformTimeVarying, timeStep);
+    }
+
+    UsdFloatMat4 identity;
+    usdBridge->SetInstanceTransform(usdHandle, identity.Data, transformTimeVarying, timeStep);
+    return;
+  }
+
+  if(transformArrayWritten)
+    usdBridge->DeleteInstanceBatches(usdHandle, transformTimeVarying, timeStep);
+  transformArrayWritten = false;
+
   if (paramData.group)
   {
     usdBridge->SetGroupRef(usdHandle, paramData.group->getUsdHandle(), groupTimeVarying, timeStep);
@@ -93,5 +170,30 @@ void UsdInstance::doCommitRefs(UsdDevice* device)
     usdBridge->DeleteGroupRef(usdHandle, groupTimeVarying, timeStep);
   }
 
-  usdBridge->SetInstanceTransform(usdHandle, paramData.transform.Data, transformTimeVarying, timeStep);
+  usdBridge->SetInstanceTransform(usdHandle, paramData.transform.data.type0.Data, transformTimeVarying, timeStep);
+}
+
+bool UsdInstance::assertTransformArray(UsdDataArray* transformArray, UsdDevice* device)
+{
+  UsdLogInfo logInfo(device, this, ANARI_INSTANCE, this->getName());
+  if(!AssertArrayType(transformArray, ANARI_FLOAT32_MAT4, logInfo, "UsdInstance commit failed: 'transform' array elements should be of type ANARI_FLOAT32_MAT4"))
+    return false;
+
+  const UsdDataLayout& layout = transformArray->getLayout();
+  if(!layout.isDense() || !layout.isOneDimensional())
+  {
+    device->reportStatus(this, ANARI_INSTANCE, ANARI_SEVERITY_ERROR, ANARI_STATUS_INVALID_ARGUMENT,
+      "UsdInstance '%s' commit failed: 'transform' array should be one-dimensional and without stride", getName());
+    return false;
+  }
+  return true;
+}
+
+void UsdInstance::observe(UsdBaseObject* caller, UsdDevice* device)
+{
+  BridgedBaseObjectType::observe(caller, device);
+
+  // Changes to the transform array also change the batches of the worlds referencing this instance
+  if(anari::isArray(caller->getType()) && device->getReadParams().instanceBatching)
+    notify(this, device);
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "UsdBridgedBaseObject.h"
 
 class UsdGroup;
+class UsdDataArray;
+
+using UsdInstanceTransformParameter = UsdMultiTypeParameter<UsdFloatMat4, UsdDataArray*, UsdUnusedParamType>;
 
 enum class UsdInstanceComponents
 {
@@ -21,7 +24,7 @@ struct UsdInstanceData
   int timeVarying = 0xFFFFFFFF; // Bitmask indicating which attributes are time-varying.
 
   UsdGroup* group = nullptr;
-  UsdFloatMat4 transform;
+  UsdInstanceTransformParameter transform = {UsdFloatMat4(), ANARI_FLOAT32_MAT4}; // Single matrix, or array of matrices for multiple placements of the group
 };
 
 class UsdInstance : public UsdBridgedBaseObject<UsdInstance, UsdInstanceData, UsdInstanceHandle, UsdInstanceComponents>
@@ -31,10 +34,16 @@ class UsdInstance : public UsdBridgedBaseObject<UsdInstance, UsdInstanceData, Us
       UsdDevice* device);
     ~UsdInstance();
 
+    void commit(UsdDevice* device) override;
+
     void remove(UsdDevice* device) override;
 
     bool isInstanceable() const;
 
+    // Returns the committed transforms, either the single matrix or the contents of a transform array
+    const UsdFloatMat4* getTransforms(uint64_t& numTransforms) const;
+    bool hasTimeVaryingTransforms() const { return isTimeVarying(UsdInstanceComponents::TRANSFORM); }
+
     static constexpr ComponentPair componentParamNames[] = {
       ComponentPair(UsdInstanceComponents::GROUP, "group"),
       ComponentPair(UsdInstanceComponents::TRANSFORM, "transform")};
@@ -43,4 +52,10 @@ class UsdInstance : public UsdBridgedBaseObject<UsdInstance, UsdInstanceData, Us
     bool deferCommit(UsdDevice* device) override;
     bool doCommitData(UsdDevice* device) override;
     void doCommitRefs(UsdDevice* device) override;
+
+    void observe(UsdBaseObject* caller, UsdDevice* device) override;
+
+    bool assertTransformArray(UsdDataArray* transformArray, UsdDevice* device);
+
+    bool transformArrayWritten = false;
 };
\ No newline at end of file
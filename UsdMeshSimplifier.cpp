@@ -0,0 +1,303 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UsdMeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+  constexpr double borderWeight = 100.0; // Relative to the area weighting of the triangle planes
+
+  void Sub(const double* a, const double* b, double* result)
+  {
+    result[0] = a[0]-b[0]; result[1] = a[1]-b[1]; result[2] = a[2]-b[2];
+  }
+
+  void Cross(const double* a, const double* b, double* result)
+  {
+    result[0] = a[1]*b[2] - a[2]*b[1];
+    result[1] = a[2]*b[0] - a[0]*b[2];
+    result[2] = a[0]*b[1] - a[1]*b[0];
+  }
+
+  double Dot(const double* a, const double* b)
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  void TriangleNormal(const double* p0, const double* p1, const double* p2, double* normal)
+  {
+    double e1[3], e2[3];
+    Sub(p1, p0, e1);
+    Sub(p2, p0, e2);
+    Cross(e1, e2, normal);
+  }
+
+  struct CollapseEntry
+  {
+    double cost;
+    uint32_t from; // Vertex which is removed
+    uint32_t to; // Vertex which remains
+    uint32_t fromStamp;
+    uint32_t toStamp;
+
+    bool operator>(const CollapseEntry& other) const { return cost > other.cost; }
+  };
+}
+
+void UsdMeshSimplifier::Quadric::addPlane(const double* normal, double dist, double weight)
+{
+  const double nx = normal[0], ny = normal[1], nz = normal[2];
+  a[0] += weight*nx*nx; a[1] += weight*nx*ny; a[2] += weight*nx*nz; a[3] += weight*nx*dist;
+  a[4] += weight*ny*ny; a[5] += weight*ny*nz; a[6] += weight*ny*dist;
+  a[7] += weight*nz*nz; a[8] += weight*nz*dist;
+  a[9] += weight*dist*dist;
+}
+
+void UsdMeshSimplifier::Quadric::add(const Quadric& other)
+{
+  for(int i = 0; i < 10; ++i)
+    a[i] += other.a[i];
+}
+
+double UsdMeshSimplifier::Quadric::evaluate(const double* pos) const
+{
+  const double x = pos[0], y = pos[1], z = pos[2];
+  return a[0]*x*x + 2.0*a[1]*x*y + 2.0*a[2]*x*z + 2.0*a[3]*x
+    + a[4]*y*y + 2.0*a[5]*y*z + 2.0*a[6]*y
+    + a[7]*z*z + 2.0*a[8]*z
+    + a[9];
+}
+
+UsdMeshSimplifier::UsdMeshSimplifier(const void* points, bool doublePoints, size_t numPoints, const int* indices, size_t numIndices)
+{
+  positions.resize(numPoints*3);
+  for(size_t i = 0; i < numPoints*3; ++i)
+  {
+    positions[i] = doublePoints ?
+      reinterpret_cast<const double*>(points)[i] :
+      static_cast<double>(reinterpret_cast<const float*>(points)[i]);
+  }
+
+  size_t numInputTriangles = numIndices / 3;
+  triangles.reserve(numInputTriangles*3);
+  for(size_t triIdx = 0; triIdx < numInputTriangles; ++triIdx)
+  {
+    const int* tri = indices + triIdx*3;
+    bool validTri = true;
+    for(int corner = 0; corner < 3; ++corner)
+      validTri = validTri && tri[corner] >= 0 && static_cast<size_t>(tri[corner]) < numPoints;
+    if(validTri)
+    {
+      for(int corner = 0; corner < 3; ++corner)
+        triangles.push_back(static_cast<uint32_t>(tri[corner]));
+    }
+  }
+  size_t numTriangles = triangles.size() / 3;
+
+  // Plane quadrics of the triangles, weighted by area
+  vertexQuadrics.resize(numPoints);
+  std::vector<double> triNormals(numTriangles*3, 0.0);
+  for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+  {
+    const uint32_t* tri = &triangles[triIdx*3];
+    double* normal = &triNormals[triIdx*3];
+    TriangleNormal(position(tri[0]), position(tri[1]), position(tri[2]), normal);
+
+    double len = std::sqrt(Dot(normal, normal));
+    if(len == 0.0)
+      continue;
+    normal[0] /= len; normal[1] /= len; normal[2] /= len;
+
+    double dist = -Dot(normal, position(tri[0]));
+    for(int corner = 0; corner < 3; ++corner)
+      vertexQuadrics[tri[corner]].addPlane(normal, dist, 0.5*len);
+  }
+
+  // Border edges are those used by a single triangle, which get a plane perpendicular to that triangle
+  struct EdgeRef
+  {
+    uint64_t key;
+    uint32_t triIdx;
+    uint32_t corner;
+
+    bool operator<(const EdgeRef& other) const { return key < other.key; }
+  };
+  std::vector<EdgeRef> edges(numTriangles*3);
+  for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+  {
+    for(uint32_t corner = 0; corner < 3; ++corner)
+    {
+      uint64_t v0 = triangles[triIdx*3+corner];
+      uint64_t v1 = triangles[triIdx*3+(corner+1)%3];
+      edges[triIdx*3+corner] = { (std::min(v0,v1) << 32) | std::max(v0,v1), static_cast<uint32_t>(triIdx), corner };
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  for(size_t edgeIdx = 0; edgeIdx < edges.size(); )
+  {
+    size_t runEnd = edgeIdx+1;
+    while(runEnd < edges.size() && edges[runEnd].key == edges[edgeIdx].key)
+      ++runEnd;
+
+    if(runEnd == edgeIdx+1)
+    {
+      const EdgeRef& edge = edges[edgeIdx];
+      uint32_t v0 = triangles[edge.triIdx*3+edge.corner];
+      uint32_t v1 = triangles[edge.triIdx*3+(edge.corner+1)%3];
+
+      double edgeDir[3], borderNormal[3];
+      Sub(position(v1), position(v0), edgeDir);
+      Cross(edgeDir, &triNormals[edge.triIdx*3], borderNormal);
+
+      double len = std::sqrt(Dot(borderNormal, borderNormal));
+      if(len != 0.0)
+      {
+        borderNormal[0] /= len; borderNormal[1] /= len; borderNormal[2] /= len;
+        double dist = -Dot(borderNormal, position(v0));
+        double weight = borderWeight * Dot(edgeDir, edgeDir);
+        vertexQuadrics[v0].addPlane(borderNormal, dist, weight);
+        vertexQuadrics[v1].addPlane(borderNormal, dist, weight);
+      }
+    }
+
+    edgeIdx = runEnd;
+  }
+}
+
+void UsdMeshSimplifier::simplify(size_t targetNumTriangles, std::vector<int>& outIndices) const
+{
+  size_t numPoints = vertexQuadrics.size();
+  size_t numTriangles = triangles.size() / 3;
+
+  std::vector<uint32_t> tris(triangles);
+  std::vector<Quadric> quadrics(vertexQuadrics);
+  std::vector<char> vertAlive(numPoints, 1);
+  std::vector<char> triAlive(numTriangles, 1);
+  std::vector<uint32_t> stamps(numPoints, 0);
+  std::vector<std::vector<uint32_t>> vertTris(numPoints);
+  for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+  {
+    for(int corner = 0; corner < 3; ++corner)
+      vertTris[tris[triIdx*3+corner]].push_back(static_cast<uint32_t>(triIdx));
+  }
+
+  std::vector<CollapseEntry> heap;
+  auto pushEdge = [&](uint32_t v0, uint32_t v1)
+  {
+    Quadric combined = quadrics[v0];
+    combined.add(quadrics[v1]);
+    double cost0 = combined.evaluate(position(v0));
+    double cost1 = combined.evaluate(position(v1));
+
+    // The endpoint with the lowest error remains
+    CollapseEntry entry = (cost0 <= cost1) ?
+      CollapseEntry{cost0, v1, v0, stamps[v1], stamps[v0]} :
+      CollapseEntry{cost1, v0, v1, stamps[v0], stamps[v1]};
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), std::greater<CollapseEntry>());
+  };
+
+  for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+  {
+    const uint32_t* tri = &tris[triIdx*3];
+    for(int corner = 0; corner < 3; ++corner)
+      pushEdge(tri[corner], tri[(corner+1)%3]); // Interior edges are pushed twice, the second entry is outdated after the first collapse
+  }
+
+  size_t numAliveTris = numTriangles;
+  while(numAliveTris > targetNumTriangles && !heap.empty())
+  {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<CollapseEntry>());
+    CollapseEntry entry = heap.back();
+    heap.pop_back();
+
+    uint32_t from = entry.from, to = entry.to;
+    if(!vertAlive[from] || !vertAlive[to] || stamps[from] != entry.fromStamp || stamps[to] != entry.toStamp)
+      continue; // Outdated
+
+    // Reject collapses which flip or degenerate any of the remaining triangles
+    bool validCollapse = true;
+    for(uint32_t triIdx : vertTris[from])
+    {
+      const uint32_t* tri = &tris[triIdx*3];
+      if(!triAlive[triIdx] || tri[0] == to || tri[1] == to || tri[2] == to)
+        continue;
+
+      const double* corners[3];
+      const double* movedCorners[3];
+      for(int corner = 0; corner < 3; ++corner)
+      {
+        corners[corner] = position(tri[corner]);
+        movedCorners[corner] = position(tri[corner] == from ? to : tri[corner]);
+      }
+
+      double normal[3], movedNormal[3];
+      TriangleNormal(corners[0], corners[1], corners[2], normal);
+      TriangleNormal(movedCorners[0], movedCorners[1], movedCorners[2], movedNormal);
+      if(Dot(normal, movedNormal) <= 0.0)
+      {
+        validCollapse = false;
+        break;
+      }
+    }
+    if(!validCollapse)
+      continue;
+
+    // Collapse from onto to
+    std::vector<uint32_t>& toTris = vertTris[to];
+    for(uint32_t triIdx : vertTris[from])
+    {
+      uint32_t* tri = &tris[triIdx*3];
+      if(!triAlive[triIdx])
+        continue;
+
+      if(tri[0] == to || tri[1] == to || tri[2] == to)
+      {
+        triAlive[triIdx] = 0;
+        --numAliveTris;
+      }
+      else
+      {
+        for(int corner = 0; corner < 3; ++corner)
+        {
+          if(tri[corner] == from)
+            tri[corner] = to;
+        }
+        toTris.push_back(triIdx);
+      }
+    }
+
+    quadrics[to].add(quadrics[from]);
+    vertAlive[from] = 0;
+    ++stamps[to];
+    std::vector<uint32_t>().swap(vertTris[from]);
+
+    toTris.erase(std::remove_if(toTris.begin(), toTris.end(), [&triAlive](uint32_t triIdx) { return !triAlive[triIdx]; }), toTris.end());
+
+    for(uint32_t triIdx : toTris)
+    {
+      const uint32_t* tri = &tris[triIdx*3];
+      for(int corner = 0; corner < 3; ++corner)
+      {
+        if(tri[corner] != to)
+          pushEdge(to, tri[corner]);
+      }
+    }
+  }
+
+  outIndices.resize(0);
+  outIndices.reserve(numAliveTris*3);
+  for(size_t triIdx = 0; triIdx < numTriangles; ++triIdx)
+  {
+    if(triAlive[triIdx])
+    {
+      for(int corner = 0; corner < 3; ++corner)
+        outIndices.push_back(static_cast<int>(tris[triIdx*3+corner]));
+    }
+  }
+}
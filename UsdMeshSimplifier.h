@@ -0,0 +1,39 @@
+// Copyright 2020 The Khronos Group
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Quadric error metric simplification of triangle meshes (Garland-Heckbert), which collapses edges onto one of
+// their endpoints. The simplified triangles therefore keep indexing the original vertices, so all per-vertex data
+// stays valid without any resampling. Mesh borders are preserved by additional quadrics perpendicular to the border.
+class UsdMeshSimplifier
+{
+  public:
+    // Points are 3-component float or double positions, indices are triangle vertex indices into the points.
+    // Triangles with out-of-range indices are dropped.
+    UsdMeshSimplifier(const void* points, bool doublePoints, size_t numPoints, const int* indices, size_t numIndices);
+
+    // Writes the indices of at most targetNumTriangles triangles to outIndices, unless collapsing further
+    // would flip triangles or the mesh runs out of edges. Can be called concurrently on the same simplifier.
+    void simplify(size_t targetNumTriangles, std::vector<int>& outIndices) const;
+
+  protected:
+    struct Quadric
+    {
+      double a[10] = {}; // Upper triangle of the symmetric 4x4 matrix
+
+      void addPlane(const double* normal, double dist, double weight);
+      void add(const Quadric& other);
+      double evaluate(const double* pos) const;
+    };
+
+    const double* position(size_t vertIdx) const { return &positions[vertIdx*3]; }
+
+    std::vector<double> positions;
+    std::vector<uint32_t> triangles; // 3 vertex indices per triangle
+    std::vector<Quadric> vertexQuadrics;
+};
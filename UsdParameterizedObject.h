@@ -135,10 +135,11 @@ protected:
   }
 
   // Convenience function for usd-compatible parameters
-  void formatUsdName(UsdSharedString* nameStr)
+  // (operates on a copy, as shared strings are interned and should never be modified in place)
+  static void formatUsdName(std::string& nameStr)
   {
-    char* name = const_cast<char*>(UsdSharedString::c_str(nameStr));
-    assert(strlen(name) > 0);
+    assert(nameStr.length() > 0);
+    char* name = &nameStr[0];
 
     auto letter = [](unsigned c) { return ((c - 'A') < 26) || ((c - 'a') < 26); };
     auto number = [](unsigned c) { return (c - '0') < 10; };
@@ -245,12 +246,12 @@ protected:
 
           if(contentUpdate)
           {
-            sharedStr = new UsdSharedString(srcCstr); // Remember to refdec
+            // Identical string values share a single interned object owned by the device,
+            // so no allocation takes place for values that have been seen before.
+            assert(device);
+            sharedStr = internStringThroughDevice(device, srcCstr);
             numBytes = sizeof(void*);
             srcAddress = &sharedStr;
-#ifdef CHECK_MEMLEAKS
-            logAllocationThroughDevice(allocDevice, sharedStr, ANARI_STRING);
-#endif
           }
         }
         else
@@ -267,13 +268,6 @@ protected:
             safeRefInc(destAddress, srcType, true);
         }
 
-        // If a string object has been created, decrease its public refcount (1 at creation)
-        if (sharedStr)
-        {
-          assert(sharedStr->useCount() == 2); // Single public and internal reference
-          sharedStr->refDec(helium::RefType::PUBLIC);
-        }
-
         // Update the type for multitype params (so far only data has been updated)
         if(contentUpdate)
           setMultiParamType(destAddress, typeInfo, srcType);
@@ -112,7 +112,7 @@ void UsdSurface::doCommitRefs(UsdDevice* device)
       }
 
       usdBridge->SetGeometryMaterialRef(usdHandle, 
-        paramData.geometry->getUsdHandle(), 
+        paramData.geometry->getDedupSource()->getUsdHandle(), 
         paramData.material->getUsdHandle(), 
         worldTimeStep,
         selectRefTime(paramData.geometryRefTimeStep, geomObjTimeStep, worldTimeStep),
@@ -123,7 +123,7 @@ void UsdSurface::doCommitRefs(UsdDevice* device)
     else
     {
       usdBridge->SetGeometryRef(usdHandle,
-        paramData.geometry->getUsdHandle(),
+        paramData.geometry->getDedupSource()->getUsdHandle(),
         worldTimeStep,
         selectRefTime(paramData.geometryRefTimeStep, geomObjTimeStep, worldTimeStep)
       );
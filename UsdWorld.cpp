@@ -11,6 +11,8 @@
 #include "UsdDataArray.h"
 #include "UsdGroup.h"
 
+#include <cstring>
+
 #define InstanceType ANARI_INSTANCE
 #define SurfaceType ANARI_SURFACE
 #define VolumeType ANARI_VOLUME
@@ -19,6 +21,7 @@ using InstanceUsdType = AnariToUsdBridgedObject<InstanceType>::Type;
 using SurfaceUsdType = AnariToUsdBridgedObject<SurfaceType>::Type;
 using VolumeUsdType = AnariToUsdBridgedObject<VolumeType>::Type;
 using LightUsdType = AnariToUsdBridgedObject<LightType>::Type;
+using GroupUsdType = AnariToUsdBridgedObject<ANARI_GROUP>::Type;
 
 DEFINE_PARAMETER_MAP(UsdWorld,
   REGISTER_PARAMETER_MACRO("name", ANARI_STRING, name)
@@ -39,6 +42,8 @@ UsdWorld::UsdWorld(const char* name, UsdDevice* device)
 
 UsdWorld::~UsdWorld()
 {
+  clearObservedInstances();
+
 #ifdef OBJECT_LIFETIME_EQUALS_USD_LIFETIME
   if(cachedBridge)
     cachedBridge->DeleteWorld(usdHandle);
@@ -54,8 +59,21 @@ bool UsdWorld::deferCommit(UsdDevice* device)
 {
   const UsdWorldData& paramData = getReadParams();
 
-  if(UsdObjectNotInitialized<InstanceUsdType>(paramData.instances) ||
-    UsdObjectNotInitialized<SurfaceUsdType>(paramData.surfaces) || 
+  if(device->getReadParams().instanceBatching && paramData.instances && anari::isObject(paramData.instances->getType()))
+  {
+    // Batched instances have no prim of their own, but their groups are referenced directly
+    const InstanceUsdType* const * instances = reinterpret_cast<const InstanceUsdType* const *>(paramData.instances->getData());
+    uint64_t numInstances = paramData.instances->getLayout().numItems1;
+    for(uint64_t i = 0; i < numInstances; ++i)
+    {
+      if(instances[i] && UsdObjectNotInitialized<GroupUsdType>(instances[i]->getReadParams().group))
+        return true;
+    }
+  }
+  else if(UsdObjectNotInitialized<InstanceUsdType>(paramData.instances))
+    return true;
+
+  if(UsdObjectNotInitialized<SurfaceUsdType>(paramData.surfaces) || 
     UsdObjectNotInitialized<VolumeUsdType>(paramData.volumes) ||
     UsdObjectNotInitialized<LightUsdType>(paramData.lights))
   {
@@ -99,9 +117,16 @@ void UsdWorld::doCommitRefs(UsdDevice* device)
 
   UsdLogInfo logInfo(device, this, ANARI_WORLD, this->getName());
 
-  ManageRefArray<InstanceType, ANARIInstance, UsdInstance>(usdHandle, paramData.instances, instancesTimeVarying, timeStep,
-    instanceHandles, instanceableValues, &UsdBridge::SetInstanceRefs, &UsdBridge::DeleteInstanceRefs,
-    usdBridge, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE");
+  if(device->getReadParams().instanceBatching)
+  {
+    commitInstanceBatches(usdBridge, instancesTimeVarying, timeStep, logInfo);
+  }
+  else
+  {
+    ManageRefArray<InstanceType, ANARIInstance, UsdInstance>(usdHandle, paramData.instances, instancesTimeVarying, timeStep,
+      instanceHandles, instanceableValues, &UsdBridge::SetInstanceRefs, &UsdBridge::DeleteInstanceRefs,
+      usdBridge, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE");
+  }
 
   ManageRefArray<SurfaceType, ANARISurface, UsdSurface>(usdHandle, paramData.surfaces, surfacesTimeVarying, timeStep,
     surfaceHandles, instanceableValues, &UsdBridge::SetSurfaceRefs, &UsdBridge::DeleteSurfaceRefs,
@@ -115,4 +140,122 @@ void UsdWorld::doCommitRefs(UsdDevice* device)
   ManageRefArray<LightType, ANARILight, UsdLight>(usdHandle, paramData.lights, lightsTimeVarying, timeStep,
     lightHandles, instanceableValues, &UsdBridge::SetLightRefs, &UsdBridge::DeleteLightRefs,
     usdBridge, logInfo, "UsdWorld commit failed: 'light' array elements should be of type ANARI_LIGHT");
-}
\ No newline at end of file
+}
+
+void UsdWorld::observe(UsdBaseObject* caller, UsdDevice* device)
+{
+  if(caller->getType() == ANARI_INSTANCE)
+  {
+    paramChanged = true;
+    device->addToCommitList(this, true); // No write to read params; just write to USD
+  }
+
+  BridgedBaseObjectType::observe(caller, device);
+}
+
+void UsdWorld::clearObservedInstances()
+{
+  for(helium::IntrusivePtr<UsdBaseObject>& instance : observedInstances)
+    instance->removeObserver(this);
+  observedInstances.resize(0);
+}
+
+void UsdWorld::commitInstanceBatches(UsdBridge* usdBridge, bool instancesTimeVarying, double timeStep, UsdLogInfo& logInfo)
+{
+  const UsdWorldData& paramData = getReadParams();
+
+  clearObservedInstances();
+
+  if(!AssertArrayType(paramData.instances, InstanceType, logInfo, "UsdWorld commit failed: 'instance' array elements should be of type ANARI_INSTANCE"))
+    return;
+
+  if(!paramData.instances)
+  {
+    batchStates.clear();
+    usdBridge->DeleteInstanceBatches(usdHandle, instancesTimeVarying, timeStep);
+    return;
+  }
+
+  // Gather the transforms of all instances per group, in order of first occurrence
+  for(auto& batchState : batchStates)
+  {
+    batchState.second.transforms.resize(0);
+    batchState.second.used = false;
+  }
+  batchGroups.resize(0);
+
+  const ANARIInstance* instances = reinterpret_cast<const ANARIInstance*>(paramData.instances->getData());
+  uint64_t numInstances = paramData.instances->getLayout().numItems1;
+  for(uint64_t i = 0; i < numInstances; ++i)
+  {
+    UsdInstance* instance = reinterpret_cast<UsdInstance*>(instances[i]);
+    if(!instance)
+      continue;
+
+    instance->addObserver(this);
+    observedInstances.emplace_back(instance);
+
+    const UsdInstanceData& instanceData = instance->getReadParams();
+    if(!instanceData.group)
+      continue;
+
+    // The batch changes over time if the set of instances or the transform of any of them does
+    InstanceBatchState& batchState = batchStates[instanceData.group];
+    if(!batchState.used)
+    {
+      batchState.used = true;
+      batchState.timeVarying = instancesTimeVarying;
+      batchGroups.push_back(instanceData.group);
+    }
+    batchState.timeVarying = batchState.timeVarying || instance->hasTimeVaryingTransforms();
+
+    uint64_t numTransforms = 0;
+    const UsdFloatMat4* transforms = instance->getTransforms(numTransforms);
+    batchState.transforms.insert(batchState.transforms.end(), transforms, transforms + numTransforms);
+  }
+
+  instanceBatches.resize(batchGroups.size());
+  for(size_t batchIdx = 0; batchIdx < batchGroups.size(); ++batchIdx)
+  {
+    const UsdGroup* group = batchGroups[batchIdx];
+    InstanceBatchState& batchState = batchStates[group];
+
+    UsdBridgeInstanceBatch& batch = instanceBatches[batchIdx];
+    batch.Group = group->getUsdHandle();
+    batch.Transforms = reinterpret_cast<const float*>(batchState.transforms.data());
+    batch.NumTransforms = batchState.transforms.size();
+    batch.TimeVarying = batchState.timeVarying;
+
+    // Only batches of which the transforms differ from what has been written to the timestep are rebuilt
+    const std::vector<UsdFloatMat4>& transforms = batchState.transforms;
+    const std::vector<UsdFloatMat4>& writtenTransforms = batchState.writtenTransforms;
+    batch.Changed = !batchState.written
+      || batchState.writtenGroup.value != batch.Group.value
+      || batchState.writtenTimeVarying != batch.TimeVarying
+      || (batch.TimeVarying && batchState.writtenTimeStep != timeStep)
+      || writtenTransforms.size() != transforms.size()
+      || memcmp(writtenTransforms.data(), transforms.data(), transforms.size()*sizeof(UsdFloatMat4)) != 0;
+
+    if(batch.Changed)
+    {
+      batchState.writtenTransforms = transforms;
+      batchState.writtenGroup = batch.Group;
+      batchState.writtenTimeVarying = batch.TimeVarying;
+      batchState.writtenTimeStep = timeStep;
+      batchState.written = true;
+    }
+  }
+
+  // Groups without instances lose their instancer
+  for(auto it = batchStates.begin(); it != batchStates.end();)
+  {
+    if(it->second.used)
+      ++it;
+    else
+      it = batchStates.erase(it);
+  }
+
+  // Instance prims written before batching was enabled would duplicate the instancers
+  usdBridge->DeleteInstanceRefs(usdHandle, instancesTimeVarying, timeStep);
+  usdBridge->SetInstanceBatches(usdHandle, instanceBatches.data(), instanceBatches.size(), instancesTimeVarying, timeStep);
+}
@@ -5,7 +5,10 @@
 
 #include "UsdBridgedBaseObject.h"
 
+#include <unordered_map>
+
 class UsdDataArray;
+class UsdGroup;
 
 enum class UsdWorldComponents
 {
@@ -47,9 +50,34 @@ class UsdWorld : public UsdBridgedBaseObject<UsdWorld, UsdWorldData, UsdWorldHan
     bool doCommitData(UsdDevice* device) override;
     void doCommitRefs(UsdDevice* device) override;
 
+    void observe(UsdBaseObject* caller, UsdDevice* device) override;
+
+    // Instances referencing the same group are written as a single point instancer (usd::instanceBatching)
+    void commitInstanceBatches(UsdBridge* usdBridge, bool instancesTimeVarying, double timeStep, UsdLogInfo& logInfo);
+    void clearObservedInstances();
+
     std::vector<UsdInstanceHandle> instanceHandles; // for convenience
     std::vector<UsdSurfaceHandle> surfaceHandles; // for convenience
     std::vector<UsdVolumeHandle> volumeHandles; // for convenience
     std::vector<UsdLightHandle> lightHandles; // for convenience
     std::vector<int> instanceableValues; // for convenience
+
+    std::vector<helium::IntrusivePtr<UsdBaseObject>> observedInstances; // Keeps observed instances alive until the observer is removed
+
+    struct InstanceBatchState
+    {
+      std::vector<UsdFloatMat4> transforms;
+      bool timeVarying = false;
+      bool used = false;
+
+      // Contents of the last write, to skip batches which are unchanged
+      std::vector<UsdFloatMat4> writtenTransforms;
+      UsdGroupHandle writtenGroup;
+      bool writtenTimeVarying = false;
+      double writtenTimeStep = 0.0;
+      bool written = false;
+    };
+    std::unordered_map<const UsdGroup*, InstanceBatchState> batchStates;
+    std::vector<const UsdGroup*> batchGroups; // for convenience
+    std::vector<UsdBridgeInstanceBatch> instanceBatches; // for convenience
 };
\ No newline at end of file
@@ -0,0 +1,397 @@
+// Copyright 2021 NVIDIA Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "anari/anari.h"
+// stb_image
+#include "stb_image_write.h"
+
+#include "anariTutorial_usd_common.h"
+
+// Exercises the output size and write performance options of the USD device over a number of timesteps:
+// - usd::geometryDedup: two meshes with identical content share a single prim
+// - usd::instanceBatching: the instances of the mesh group are written as a single point instancer
+// - usd::timeSampleSharing: particle colors never change and stay uniform, radii change halfway
+//   through the timeline, after which they are written for every timestep. Of the wave mesh, only
+//   the faces of the moving half are written for every timestep.
+// - usd::attribute0.precision: the per-particle temperature is written quantized to normalized8
+// - usd::clipStages.packed: the clip data of all geometries of a timestep is written to a single clip stage
+
+#define NUM_PARTICLES 64
+#define NUM_MESH_INSTANCES 4
+#define WAVE_GRID_SIZE 16
+
+int main(int argc, const char **argv)
+{
+  parseArgs(argc, argv);
+
+  stbi_flip_vertically_on_write(1);
+
+  // image size
+  int frameSize[2] = { 1024, 768 };
+
+  // camera
+  float cam_pos[] = {40.0f, 60.0f, 80.0f};
+  float cam_up[] = {0.f, 1.f, 0.f};
+  float cam_view[] = {-0.5f, -0.75f, -1.0f};
+
+  // triangle mesh data
+  float vertex[] = {-1.0f, -1.0f, 3.0f,
+      -1.0f, 1.0f, 3.0f,
+      1.0f, -1.0f, 3.0f,
+      0.1f, 0.1f, 0.3f};
+  int32_t index[] = {0, 1, 2, 1, 2, 3};
+
+  // particle data
+  float particleVertex[NUM_PARTICLES*3];
+  float particleVelocity[NUM_PARTICLES*3];
+  float particleColor[NUM_PARTICLES*4];
+  float particleRadius[NUM_PARTICLES];
+  float particleTemperature[NUM_PARTICLES];
+
+  for (int p = 0; p < NUM_PARTICLES; ++p)
+  {
+    float pFrac = (float)p / NUM_PARTICLES;
+
+    particleVertex[p*3] = 20.0f * cos(pFrac * 2.0f * PI);
+    particleVertex[p*3+1] = 2.0f * (p % 8);
+    particleVertex[p*3+2] = 20.0f * sin(pFrac * 2.0f * PI);
+
+    particleVelocity[p*3] = 0.0f;
+    particleVelocity[p*3+1] = 1.0f + pFrac;
+    particleVelocity[p*3+2] = 0.0f;
+
+    particleColor[p*4] = pFrac;
+    particleColor[p*4+1] = 0.5f;
+    particleColor[p*4+2] = 1.0f - pFrac;
+    particleColor[p*4+3] = 1.0f;
+  }
+
+  // wave mesh data, of which only the right half moves
+  float waveVertex[WAVE_GRID_SIZE*WAVE_GRID_SIZE*3];
+  int32_t waveIndex[(WAVE_GRID_SIZE-1)*(WAVE_GRID_SIZE-1)*6];
+
+  for (int y = 0; y < WAVE_GRID_SIZE-1; ++y)
+  {
+    for (int x = 0; x < WAVE_GRID_SIZE-1; ++x)
+    {
+      int32_t* quadIndex = waveIndex + (y*(WAVE_GRID_SIZE-1) + x)*6;
+      int32_t v = y*WAVE_GRID_SIZE + x;
+      quadIndex[0] = v;
+      quadIndex[1] = v + 1;
+      quadIndex[2] = v + WAVE_GRID_SIZE;
+      quadIndex[3] = v + 1;
+      quadIndex[4] = v + WAVE_GRID_SIZE + 1;
+      quadIndex[5] = v + WAVE_GRID_SIZE;
+    }
+  }
+
+  printf("initialize ANARI...");
+
+  ANARILibrary lib = anariLoadLibrary(g_libraryType, statusFunc, NULL);
+
+  ANARIDevice dev = anariNewDevice(lib, "usd");
+
+  if (!dev) {
+    printf("\n\nERROR: could not load device '%s'\n", "usd");
+    return 1;
+  }
+
+  int outputBinary = 0;
+  int connLogVerbosity = 0;
+
+  anariSetParameter(dev, dev, "usd::connection.logVerbosity", ANARI_INT32, &connLogVerbosity);
+  anariSetParameter(dev, dev, "usd::serialize.outputBinary", ANARI_BOOL, &outputBinary);
+
+  // Immutable parameters, which have to be set before the first commit of the device
+  int enableOption = 1;
+  anariSetParameter(dev, dev, "usd::geometryDedup", ANARI_BOOL, &enableOption);
+  anariSetParameter(dev, dev, "usd::instanceBatching", ANARI_BOOL, &enableOption);
+  anariSetParameter(dev, dev, "usd::timeSampleSharing", ANARI_BOOL, &enableOption);
+  anariSetParameter(dev, dev, "usd::clipStages.packed", ANARI_BOOL, &enableOption);
+
+  // commit device
+  anariCommitParameters(dev, dev);
+
+  printf("done!\n");
+  printf("setting up camera...");
+
+  // create and setup camera
+  ANARICamera camera = anariNewCamera(dev, "perspective");
+  float aspect = frameSize[0] / (float)frameSize[1];
+  anariSetParameter(dev, camera, "aspect", ANARI_FLOAT32, &aspect);
+  anariSetParameter(dev, camera, "position", ANARI_FLOAT32_VEC3, cam_pos);
+  anariSetParameter(dev, camera, "direction", ANARI_FLOAT32_VEC3, cam_view);
+  anariSetParameter(dev, camera, "up", ANARI_FLOAT32_VEC3, cam_up);
+  anariCommitParameters(dev, camera); // commit each object to indicate mods are done
+
+  printf("done!\n");
+  printf("setting up scene...");
+
+  int numTimeSteps = 10;
+
+  for (int timeIdx = 0; timeIdx < numTimeSteps; ++timeIdx)
+  {
+    double timeValue = (double)timeIdx;
+
+    anariSetParameter(dev, dev, "usd::time", ANARI_FLOAT64, &timeValue);
+    anariCommitParameters(dev, dev);
+
+    ANARIWorld world = anariNewWorld(dev);
+    ANARIArray1D array;
+
+    // Two meshes with identical, non-timevarying content
+    ANARISurface meshSurfaces[2];
+    for (int m = 0; m < 2; ++m)
+    {
+      char meshName[64], surfaceName[64];
+      snprintf(meshName, sizeof(meshName), "featuresMesh_%d", m);
+      snprintf(surfaceName, sizeof(surfaceName), "featuresMeshSurface_%d", m);
+
+      ANARIGeometry mesh = anariNewGeometry(dev, "triangle");
+      anariSetParameter(dev, mesh, "name", ANARI_STRING, meshName);
+
+      array = anariNewArray1D(dev, vertex, 0, 0, ANARI_FLOAT32_VEC3, 4);
+      anariCommitParameters(dev, array);
+      anariSetParameter(dev, mesh, "vertex.position", ANARI_ARRAY, &array);
+      anariRelease(dev, array); // we are done using this handle
+
+      array = anariNewArray1D(dev, index, 0, 0, ANARI_INT32_VEC3, 2);
+      anariCommitParameters(dev, array);
+      anariSetParameter(dev, mesh, "primitive.index", ANARI_ARRAY, &array);
+      anariRelease(dev, array);
+
+      int timeVarying = 0; // Only geometries without timevarying data are deduplicated
+      anariSetParameter(dev, mesh, "usd::timeVarying", ANARI_INT32, &timeVarying);
+      anariSetParameter(dev, mesh, "usd::time", ANARI_FLOAT64, &timeValue);
+      anariCommitParameters(dev, mesh);
+
+      meshSurfaces[m] = anariNewSurface(dev);
+      anariSetParameter(dev, meshSurfaces[m], "name", ANARI_STRING, surfaceName);
+      anariSetParameter(dev, meshSurfaces[m], "geometry", ANARI_GEOMETRY, &mesh);
+      anariCommitParameters(dev, meshSurfaces[m]);
+      anariRelease(dev, mesh);
+    }
+
+    ANARIGroup meshGroup = anariNewGroup(dev);
+    anariSetParameter(dev, meshGroup, "name", ANARI_STRING, "featuresMeshGroup");
+    array = anariNewArray1D(dev, meshSurfaces, 0, 0, ANARI_SURFACE, 2);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, meshGroup, "surface", ANARI_ARRAY, &array);
+    anariCommitParameters(dev, meshGroup);
+    anariRelease(dev, meshSurfaces[0]);
+    anariRelease(dev, meshSurfaces[1]);
+    anariRelease(dev, array);
+
+    // Wave mesh with timevarying positions
+    for (int y = 0; y < WAVE_GRID_SIZE; ++y)
+    {
+      for (int x = 0; x < WAVE_GRID_SIZE; ++x)
+      {
+        float* v = waveVertex + (y*WAVE_GRID_SIZE + x)*3;
+        v[0] = 2.0f * x - 40.0f;
+        v[1] = (x < WAVE_GRID_SIZE/2) ? 0.0f : 2.0f * sin((0.2f * x + 0.3f * timeIdx) * PI);
+        v[2] = 2.0f * y - 40.0f;
+      }
+    }
+
+    ANARIGeometry waveMesh = anariNewGeometry(dev, "triangle");
+    anariSetParameter(dev, waveMesh, "name", ANARI_STRING, "featuresWaveMesh");
+
+    array = anariNewArray1D(dev, waveVertex, 0, 0, ANARI_FLOAT32_VEC3, WAVE_GRID_SIZE*WAVE_GRID_SIZE);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, waveMesh, "vertex.position", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    array = anariNewArray1D(dev, waveIndex, 0, 0, ANARI_INT32_VEC3, (WAVE_GRID_SIZE-1)*(WAVE_GRID_SIZE-1)*2);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, waveMesh, "primitive.index", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    anariSetParameter(dev, waveMesh, "usd::time", ANARI_FLOAT64, &timeValue);
+    anariCommitParameters(dev, waveMesh);
+
+    ANARISurface waveSurface = anariNewSurface(dev);
+    anariSetParameter(dev, waveSurface, "name", ANARI_STRING, "featuresWaveSurface");
+    anariSetParameter(dev, waveSurface, "geometry", ANARI_GEOMETRY, &waveMesh);
+    anariCommitParameters(dev, waveSurface);
+    anariRelease(dev, waveMesh);
+
+    // Moving particles
+    float timeVertex[NUM_PARTICLES*3];
+    for (int v = 0; v < NUM_PARTICLES*3; ++v)
+      timeVertex[v] = particleVertex[v] + particleVelocity[v] * timeIdx;
+
+    for (int p = 0; p < NUM_PARTICLES; ++p)
+    {
+      particleRadius[p] = (timeIdx < numTimeSteps/2) ? 0.5f : 0.5f + 0.1f * (timeIdx + p % 4);
+      particleTemperature[p] = 300.0f + 10.0f * sin(((float)p / NUM_PARTICLES + 0.1f * timeIdx) * 2.0f * PI);
+    }
+
+    ANARIGeometry particles = anariNewGeometry(dev, "sphere");
+    anariSetParameter(dev, particles, "name", ANARI_STRING, "featuresParticles");
+
+    array = anariNewArray1D(dev, timeVertex, 0, 0, ANARI_FLOAT32_VEC3, NUM_PARTICLES);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particles, "vertex.position", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    array = anariNewArray1D(dev, particleVelocity, 0, 0, ANARI_FLOAT32_VEC3, NUM_PARTICLES);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particles, "vertex.velocity", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    array = anariNewArray1D(dev, particleColor, 0, 0, ANARI_FLOAT32_VEC4, NUM_PARTICLES);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particles, "vertex.color", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    array = anariNewArray1D(dev, particleRadius, 0, 0, ANARI_FLOAT32, NUM_PARTICLES);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particles, "vertex.radius", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    array = anariNewArray1D(dev, particleTemperature, 0, 0, ANARI_FLOAT32, NUM_PARTICLES);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particles, "vertex.attribute0", ANARI_ARRAY, &array);
+    anariRelease(dev, array);
+
+    anariSetParameter(dev, particles, "usd::attribute0.name", ANARI_STRING, "temperature");
+    anariSetParameter(dev, particles, "usd::attribute0.precision", ANARI_STRING, "normalized8");
+    anariSetParameter(dev, particles, "usd::time", ANARI_FLOAT64, &timeValue);
+    anariCommitParameters(dev, particles);
+
+    ANARIMaterial mat = anariNewMaterial(dev, "matte");
+    anariSetParameter(dev, mat, "name", ANARI_STRING, "featuresParticleMaterial");
+    anariSetParameter(dev, mat, "color", ANARI_STRING, "color");
+    anariCommitParameters(dev, mat);
+
+    ANARISurface particleSurface = anariNewSurface(dev);
+    anariSetParameter(dev, particleSurface, "name", ANARI_STRING, "featuresParticleSurface");
+    anariSetParameter(dev, particleSurface, "geometry", ANARI_GEOMETRY, &particles);
+    anariSetParameter(dev, particleSurface, "material", ANARI_MATERIAL, &mat);
+    anariCommitParameters(dev, particleSurface);
+    anariRelease(dev, particles);
+    anariRelease(dev, mat);
+
+    ANARIGroup particleGroup = anariNewGroup(dev);
+    anariSetParameter(dev, particleGroup, "name", ANARI_STRING, "featuresParticleGroup");
+    ANARISurface particleGroupSurfaces[2] = { particleSurface, waveSurface };
+    array = anariNewArray1D(dev, particleGroupSurfaces, 0, 0, ANARI_SURFACE, 2);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, particleGroup, "surface", ANARI_ARRAY, &array);
+    anariCommitParameters(dev, particleGroup);
+    anariRelease(dev, particleSurface);
+    anariRelease(dev, waveSurface);
+    anariRelease(dev, array);
+
+    // Several instances of the mesh group, and one of the particle group
+    ANARIInstance instances[NUM_MESH_INSTANCES+1];
+    for (int i = 0; i < NUM_MESH_INSTANCES; ++i)
+    {
+      char instanceName[64];
+      snprintf(instanceName, sizeof(instanceName), "featuresMeshInstance_%d", i);
+
+      float transform[16] = {
+        3.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 3.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 3.0f, 0.0f,
+        10.0f * i, 0.0f, 0.5f * timeIdx, 1.0f };
+
+      instances[i] = anariNewInstance(dev, "transform");
+      anariSetParameter(dev, instances[i], "name", ANARI_STRING, instanceName);
+      anariSetParameter(dev, instances[i], "transform", ANARI_FLOAT32_MAT4, transform);
+      anariSetParameter(dev, instances[i], "group", ANARI_GROUP, &meshGroup);
+      anariCommitParameters(dev, instances[i]);
+    }
+    anariRelease(dev, meshGroup);
+
+    instances[NUM_MESH_INSTANCES] = anariNewInstance(dev, "transform");
+    anariSetParameter(dev, instances[NUM_MESH_INSTANCES], "name", ANARI_STRING, "featuresParticleInstance");
+    anariSetParameter(dev, instances[NUM_MESH_INSTANCES], "group", ANARI_GROUP, &particleGroup);
+    anariCommitParameters(dev, instances[NUM_MESH_INSTANCES]);
+    anariRelease(dev, particleGroup);
+
+    // create and setup light for Ambient Occlusion
+    ANARILight light = anariNewLight(dev, "hdri");
+    anariSetParameter(dev, light, "name", ANARI_STRING, "featuresLight");
+    float lightRadiance = 1.0f;
+    anariSetParameter(dev, light, "radiance", ANARI_FLOAT32, &lightRadiance);
+    anariCommitParameters(dev, light);
+    array = anariNewArray1D(dev, &light, 0, 0, ANARI_LIGHT, 1);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, world, "light", ANARI_ARRAY, &array);
+    anariRelease(dev, light);
+    anariRelease(dev, array);
+
+    // put the instances in the world
+    anariSetParameter(dev, world, "name", ANARI_STRING, "featuresWorld");
+    array = anariNewArray1D(dev, instances, 0, 0, ANARI_INSTANCE, NUM_MESH_INSTANCES+1);
+    anariCommitParameters(dev, array);
+    anariSetParameter(dev, world, "instance", ANARI_ARRAY, &array);
+    for (int i = 0; i < NUM_MESH_INSTANCES+1; ++i)
+      anariRelease(dev, instances[i]);
+    anariRelease(dev, array);
+    anariCommitParameters(dev, world);
+
+    // create renderer
+    ANARIRenderer renderer =
+      anariNewRenderer(dev, "hydra");
+
+    // complete setup of renderer
+    float bgColor[4] = { 1.f, 1.f, 1.f, 1.f }; // white
+    anariSetParameter(dev, renderer, "backgroundColor", ANARI_FLOAT32_VEC4, bgColor);
+    anariCommitParameters(dev, renderer);
+
+    // create and setup frame
+    ANARIFrame frame = anariNewFrame(dev);
+    ANARIDataType colFormat = ANARI_UFIXED8_RGBA_SRGB;
+    ANARIDataType depthFormat = ANARI_FLOAT32;
+    anariSetParameter(dev, frame, "size", ANARI_UINT32_VEC2, frameSize);
+    anariSetParameter(dev, frame, "channel.color", ANARI_DATA_TYPE, &colFormat);
+    anariSetParameter(dev, frame, "channel.depth", ANARI_DATA_TYPE, &depthFormat);
+
+    anariSetParameter(dev, frame, "renderer", ANARI_RENDERER, &renderer);
+    anariSetParameter(dev, frame, "camera", ANARI_CAMERA, &camera);
+    anariSetParameter(dev, frame, "world", ANARI_WORLD, &world);
+
+    anariCommitParameters(dev, frame);
+
+    printf("rendering frame...");
+
+    // render one frame
+    anariRenderFrame(dev, frame);
+    anariFrameReady(dev, frame, ANARI_WAIT);
+
+    // access frame and write its content as PNG file
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "featuresTutorial_%d.png", timeIdx);
+    writePNG(fileName, dev, frame);
+
+    printf("done!\n");
+
+    // final cleanups
+    anariRelease(dev, renderer);
+    anariRelease(dev, frame);
+    anariRelease(dev, world);
+
+    // USD-SPECIFIC RUNTIME:
+
+    // Remove unused prims in usd
+    // Only useful when objects are possibly removed over the whole timeline
+    anariSetParameter(dev, dev, "usd::garbageCollect", ANARI_VOID_POINTER, 0);
+
+    // ~
+  }
+
+  anariRelease(dev, camera);
+
+  anariRelease(dev, dev);
+
+  printf("done!\n");
+
+  return 0;
+}